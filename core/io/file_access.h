@@ -179,6 +179,8 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; } ///< get a pointer to the next p_length bytes without copying them and advance past them, or nullptr if the file is not memory-backed. Valid until the file is closed.
+	virtual const uint8_t *map_read_only(uint64_t &r_length) { return nullptr; } ///< map the whole file read-only into memory, or nullptr if unsupported. Valid until the file is closed.
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
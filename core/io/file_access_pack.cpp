@@ -30,7 +30,9 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/compression.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/version.h"
@@ -47,7 +49,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +57,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -63,6 +66,14 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	}
 	pf.src = p_src;
 
+	const MappedPack *mp = mapped_packs.getptr(p_pkg_path);
+	// Compressed entries are smaller than p_size, their blocks are bounds checked when opened.
+	if (mp && !p_encrypted && p_ofs <= mp->length && (p_compressed || p_size <= mp->length - p_ofs)) {
+		pf.mapped_file = mp->file;
+		pf.mapped_data = mp->data + p_ofs;
+		pf.mapped_size = mp->length - p_ofs;
+	}
+
 	if (!exists || p_replace_files) {
 		files[pmd5] = pf;
 	}
@@ -121,6 +132,30 @@ void PackedData::remove_path(const String &p_path) {
 	files.erase(pmd5);
 }
 
+bool PackedData::map_pack(const String &p_pkg_path, const Ref<FileAccess> &p_file) {
+	if (mapped_packs.has(p_pkg_path)) {
+		return true;
+	}
+
+	// Accessing a mapping past the end of a truncated file faults, where a read
+	// would only fail. Packs in the user data directory, such as downloaded
+	// patches, can be rewritten by the project while in use, so they're read
+	// through FileAccess.
+	const String user_dir = OS::get_singleton()->get_user_data_dir();
+	if (p_pkg_path.begins_with("user://") || (!user_dir.is_empty() && p_pkg_path.simplify_path().begins_with(user_dir))) {
+		return false;
+	}
+
+	MappedPack mp;
+	mp.data = p_file->map_read_only(mp.length);
+	if (!mp.data) {
+		return false; // Not supported by this platform or file, reads go through FileAccess.
+	}
+	mp.file = p_file;
+	mapped_packs[p_pkg_path] = mp;
+	return true;
+}
+
 void PackedData::add_pack_source(PackSource *p_source) {
 	if (p_source != nullptr) {
 		sources.push_back(p_source);
@@ -156,6 +191,7 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 
 void PackedData::clear() {
 	files.clear();
+	mapped_packs.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -265,7 +301,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_UNCOMPRESSED, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.", ver_major, ver_minor));
 
 	uint32_t pack_flags = f->get_32();
@@ -285,6 +321,11 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		file_base += pck_start_pos;
 	}
 
+	// Map the whole pack once so its files can be read without seeking and
+	// copying through a separate handle each. The mapping is shared with other
+	// processes using the same pack through the page cache.
+	PackedData::get_singleton()->map_pack(p_path, f);
+
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -316,11 +357,12 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
+		ERR_FAIL_COND_V_MSG((flags & PACK_FILE_COMPRESSED) && version < PACK_FORMAT_VERSION, false, vformat("Compressed file in a version %d pack: %s.", version, path));
 
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
 		}
 	}
 
@@ -339,7 +381,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -355,7 +399,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped && !pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -394,16 +440,51 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (pf.compressed) {
+		uint64_t from = pos - to_read;
+		uint64_t done = 0;
+		while (done < (uint64_t)to_read) {
+			const CompressedBlock *b = _get_block(from / block_size);
+			if (!b) {
+				eof = true;
+				pos = from;
+				return done;
+			}
+			const uint32_t block_ofs = from % block_size;
+			const uint64_t n = MIN(b->size - block_ofs, (uint64_t)to_read - done);
+			memcpy(p_dst + done, b->data.ptr() + block_ofs, n);
+			done += n;
+			from += n;
+		}
+	} else if (mapped) {
+		memcpy(p_dst, mapped + pos - to_read, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), nullptr, "File must be opened before use.");
+
+	// Views into decompressed blocks would not outlive the block cache.
+	if (!mapped || pf.compressed || eof || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = mapped + pos;
+	pos += p_length;
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped && !pf.compressed) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -426,12 +507,207 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 void FileAccessPack::close() {
+	for (CompressedBlock &b : blocks) {
+		_release_block(b);
+	}
+	blocks.clear();
+	window_begin = 0;
+	window_end = 0;
+
 	f = Ref<FileAccess>();
+	mapped = nullptr;
+}
+
+void FileAccessPack::_decompress_block(void *p_block) {
+	CompressedBlock *b = (CompressedBlock *)p_block;
+	b->data.resize(b->size);
+	int ret = Compression::decompress(b->data.ptrw(), b->size, b->src, b->csize, Compression::MODE_ZSTD);
+	b->failed = ret != (int)b->size;
+	b->src_buffer.clear();
+}
+
+void FileAccessPack::_read_raw(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const {
+	if (mapped) {
+		memcpy(p_dst, mapped + p_offset, p_length);
+	} else {
+		f->seek(off + p_offset);
+		f->get_buffer(p_dst, p_length);
+	}
+}
+
+Error FileAccessPack::_open_compressed() {
+	uint8_t header[8];
+	ERR_FAIL_COND_V(mapped && pf.mapped_size < 8, ERR_FILE_CORRUPT);
+	_read_raw(0, header, 8);
+	block_size = decode_uint32(header);
+	const uint32_t block_count = decode_uint32(header + 4);
+	ERR_FAIL_COND_V(block_size == 0 || block_count != (pf.size + block_size - 1) / block_size, ERR_FILE_CORRUPT);
+
+	uint64_t table_size = uint64_t(block_count) * 4;
+	ERR_FAIL_COND_V(mapped && pf.mapped_size < 8 + table_size, ERR_FILE_CORRUPT);
+	Vector<uint8_t> table;
+	table.resize(table_size);
+	_read_raw(8, table.ptrw(), table_size);
+
+	blocks.resize(block_count);
+	uint64_t block_ofs = 8 + table_size;
+	for (uint32_t i = 0; i < block_count; i++) {
+		CompressedBlock &b = blocks[i];
+		b.offset = block_ofs;
+		b.csize = decode_uint32(table.ptr() + i * 4);
+		b.size = MIN((uint64_t)block_size, pf.size - uint64_t(i) * block_size);
+		block_ofs += b.csize;
+	}
+	ERR_FAIL_COND_V(mapped && pf.mapped_size < block_ofs, ERR_FILE_CORRUPT);
+
+	return OK;
+}
+
+void FileAccessPack::_request_block(uint32_t p_block) const {
+	CompressedBlock &b = blocks[p_block];
+	if (b.state != BLOCK_IDLE) {
+		return;
+	}
+
+	// Compressed data is fetched on this thread, only decompression is handed
+	// to the pool, as the underlying FileAccess isn't thread safe.
+	if (mapped) {
+		b.src = mapped + b.offset;
+	} else {
+		b.src_buffer.resize(b.csize);
+		_read_raw(b.offset, b.src_buffer.ptrw(), b.csize);
+		b.src = b.src_buffer.ptr();
+	}
+
+	if (blocks.size() == 1) {
+		// Nothing to overlap with, skip the task overhead.
+		_decompress_block(&b);
+		b.state = BLOCK_READY;
+		return;
+	}
+
+	b.task = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessPack::_decompress_block, &b, false, "Decompress PCK block");
+	b.state = BLOCK_PENDING;
+}
+
+const FileAccessPack::CompressedBlock *FileAccessPack::_get_block(uint32_t p_block) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_block, blocks.size(), nullptr);
+
+	// Keep only the prefetch window decompressed, releasing the blocks that
+	// left it since the previous call.
+	const uint32_t new_window_end = MIN(p_block + PREFETCH_BLOCKS, blocks.size());
+	for (uint32_t i = window_begin; i < window_end; i++) {
+		if (i < p_block || i >= new_window_end) {
+			_release_block(blocks[i]);
+		}
+	}
+	window_begin = p_block;
+	window_end = new_window_end;
+
+	for (uint32_t i = p_block; i < window_end; i++) {
+		_request_block(i);
+	}
+
+	CompressedBlock &b = blocks[p_block];
+	if (b.state == BLOCK_PENDING) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(b.task);
+		b.task = WorkerThreadPool::INVALID_TASK_ID;
+		b.state = BLOCK_READY;
+	}
+
+	ERR_FAIL_COND_V_MSG(b.failed, nullptr, vformat("Failed to decompress block %d of pack-referenced file '%s'.", p_block, String(pf.pack)));
+	return &b;
+}
+
+void FileAccessPack::_release_block(CompressedBlock &p_block) const {
+	if (p_block.state == BLOCK_PENDING) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_block.task);
+		p_block.task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+	p_block.state = BLOCK_IDLE;
+	p_block.src = nullptr;
+	p_block.src_buffer.clear();
+	p_block.data.clear();
+	p_block.failed = false;
+}
+
+Vector<uint8_t> FileAccessPack::compress_data(const uint8_t *p_data, uint64_t p_size) {
+	const uint32_t block_count = (p_size + PACK_COMPRESSION_BLOCK_SIZE - 1) / PACK_COMPRESSION_BLOCK_SIZE;
+	if (block_count == 0) {
+		return Vector<uint8_t>();
+	}
+
+	struct CompressJob {
+		const uint8_t *src = nullptr;
+		uint64_t size = 0;
+		Vector<uint8_t> *out = nullptr;
+
+		static void compress_block(void *p_job, uint32_t p_index) {
+			CompressJob *job = (CompressJob *)p_job;
+			const uint64_t from = uint64_t(p_index) * PACK_COMPRESSION_BLOCK_SIZE;
+			const int block = MIN((uint64_t)PACK_COMPRESSION_BLOCK_SIZE, job->size - from);
+			Vector<uint8_t> &dst = job->out[p_index];
+			dst.resize(Compression::get_max_compressed_buffer_size(block, Compression::MODE_ZSTD));
+			int ret = Compression::compress(dst.ptrw(), job->src + from, block, Compression::MODE_ZSTD);
+			dst.resize(ret > 0 ? ret : 0);
+		}
+	};
+
+	Vector<Vector<uint8_t>> compressed_blocks;
+	compressed_blocks.resize(block_count);
+
+	CompressJob job;
+	job.src = p_data;
+	job.size = p_size;
+	job.out = compressed_blocks.ptrw();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&CompressJob::compress_block, &job, block_count, -1, true, "Compress PCK file");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	uint64_t total = 8 + uint64_t(block_count) * 4;
+	for (uint32_t i = 0; i < block_count; i++) {
+		if (compressed_blocks[i].is_empty()) {
+			return Vector<uint8_t>();
+		}
+		total += compressed_blocks[i].size();
+	}
+	// Not worth paying for decompression on load.
+	if (total >= p_size - p_size / 16) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> result;
+	result.resize(total);
+	uint8_t *w = result.ptrw();
+	encode_uint32(PACK_COMPRESSION_BLOCK_SIZE, w);
+	encode_uint32(block_count, w + 4);
+	uint64_t ofs = 8 + uint64_t(block_count) * 4;
+	for (uint32_t i = 0; i < block_count; i++) {
+		encode_uint32(compressed_blocks[i].size(), w + 8 + i * 4);
+		memcpy(w + ofs, compressed_blocks[i].ptr(), compressed_blocks[i].size());
+		ofs += compressed_blocks[i].size();
+	}
+	return result;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	if (pf.mapped_data) {
+		// Served straight from the pack mapping. The shared handle is only kept
+		// to hold the mapping alive, it is never read from or seeked.
+		f = pf.mapped_file;
+		mapped = pf.mapped_data;
+		off = 0;
+		if (pf.compressed && _open_compressed() != OK) {
+			close();
+			ERR_FAIL_MSG(vformat("Can't open compressed pack-referenced file '%s'.", String(pf.pack)));
+		}
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), vformat("Can't open pack-referenced file '%s'.", String(pf.pack)));
 
 	f->seek(pf.offset);
@@ -453,8 +729,18 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
+
+	if (pf.compressed) {
+		Error err = _open_compressed();
+		if (err != OK) {
+			close();
+			ERR_FAIL_MSG(vformat("Can't open compressed pack-referenced file '%s'.", String(pf.pack)));
+		}
+	}
+}
+
+FileAccessPack::~FileAccessPack() {
+	close();
 }
 
 //////////////////////////////////////////////////////////////////////////////////
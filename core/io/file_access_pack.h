@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -40,8 +41,11 @@
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
-// The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+// The current packed file format version number. Version 3 adds compressed
+// files (PACK_FILE_COMPRESSED), which older engines can't read. Packs without
+// them are still written as version 2 so these can load them.
+#define PACK_FORMAT_VERSION 3
+#define PACK_FORMAT_VERSION_UNCOMPRESSED 2
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -51,8 +55,13 @@ enum PackFlags {
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
+	PACK_FILE_COMPRESSED = 1 << 2,
 };
 
+// Uncompressed size of the independently compressed blocks of a
+// PACK_FILE_COMPRESSED entry.
+#define PACK_COMPRESSION_BLOCK_SIZE (128 * 1024)
+
 class PackSource;
 
 class PackedData {
@@ -68,6 +77,10 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
+		Ref<FileAccess> mapped_file; // Keeps the mapping below alive.
+		const uint8_t *mapped_data = nullptr; // Start of the file inside a memory-mapped pack, if any.
+		uint64_t mapped_size = 0; // Bytes available from mapped_data to the end of the pack.
 	};
 
 private:
@@ -100,6 +113,14 @@ private:
 
 	HashMap<PathMD5, PackedFile, PathMD5> files;
 
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+	};
+
+	HashMap<String, MappedPack> mapped_packs;
+
 	Vector<PackSource *> sources;
 
 	PackedDir *root = nullptr;
@@ -112,8 +133,9 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 	void remove_path(const String &p_path);
+	bool map_pack(const String &p_pkg_path, const Ref<FileAccess> &p_file); // for PackSource
 	uint8_t *get_file_hash(const String &p_path);
 	HashSet<String> get_file_paths() const;
 
@@ -156,6 +178,44 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *mapped = nullptr;
+
+	// PACK_FILE_COMPRESSED entries are stored as independently compressed
+	// blocks. Blocks ahead of the read position are decompressed in parallel
+	// on the WorkerThreadPool, so sequential reads rarely wait.
+	enum {
+		PREFETCH_BLOCKS = 8,
+	};
+
+	enum BlockState {
+		BLOCK_IDLE,
+		BLOCK_PENDING,
+		BLOCK_READY,
+	};
+
+	struct CompressedBlock {
+		uint64_t offset = 0; // Of the compressed data, relative to the start of the entry.
+		uint32_t csize = 0;
+		uint32_t size = 0;
+		BlockState state = BLOCK_IDLE;
+		const uint8_t *src = nullptr;
+		Vector<uint8_t> src_buffer; // Holds the compressed data when the pack isn't mapped.
+		Vector<uint8_t> data;
+		bool failed = false;
+		WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	mutable LocalVector<CompressedBlock> blocks;
+	mutable uint32_t window_begin = 0; // Blocks in [window_begin, window_end) may hold data.
+	mutable uint32_t window_end = 0;
+	uint32_t block_size = 0;
+
+	static void _decompress_block(void *p_block);
+	Error _open_compressed();
+	void _read_raw(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const;
+	void _request_block(uint32_t p_block) const;
+	const CompressedBlock *_get_block(uint32_t p_block) const;
+	void _release_block(CompressedBlock &p_block) const;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -177,6 +237,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -190,7 +251,10 @@ public:
 
 	virtual void close() override;
 
+	static Vector<uint8_t> compress_data(const uint8_t *p_data, uint64_t p_size);
+
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	~FileAccessPack();
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -0,0 +1,702 @@
+/**************************************************************************/
+/*  json_stream_parser.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_stream_parser.h"
+
+#include "core/os/os.h"
+
+static const char *_json_token_names[] = {
+	"'{'",
+	"'}'",
+	"'['",
+	"']'",
+	"identifier",
+	"string",
+	"number",
+	"':'",
+	"','",
+	"EOF",
+};
+
+static bool _parse_hex(const char *p_str, int64_t p_len, char32_t &r_value) {
+	if (p_len < 4) {
+		return false;
+	}
+	r_value = 0;
+	for (int i = 0; i < 4; i++) {
+		const char c = p_str[i];
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			v = c - 'A' + 10;
+		} else {
+			return false;
+		}
+		r_value = (r_value << 4) | v;
+	}
+	return true;
+}
+
+static void _append_utf8(LocalVector<char> &r_buffer, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buffer.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_buffer.push_back(0xc0 | (p_char >> 6));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x10000) {
+		r_buffer.push_back(0xe0 | (p_char >> 12));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		r_buffer.push_back(0xf0 | (p_char >> 18));
+		r_buffer.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	}
+}
+
+uint8_t *JSONStreamParser::_reserve(int64_t p_size) {
+	if (pos > 0) {
+		// Drop consumed input, only the start of an incomplete token remains.
+		uint8_t *w = buffer.ptrw();
+		memmove(w, w + pos, end - pos);
+		end -= pos;
+		pos = 0;
+	}
+	if (end + p_size > buffer.size()) {
+		buffer.resize(MAX(end + p_size, buffer.size() * 2));
+	}
+	return buffer.ptrw() + end;
+}
+
+bool JSONStreamParser::_fill_from_stream() {
+	if (stream.is_null()) {
+		return false;
+	}
+	const int available = stream->get_available_bytes();
+	if (available <= 0) {
+		return false;
+	}
+
+	const int size = MIN(available, STREAM_CHUNK_SIZE);
+	uint8_t *w = _reserve(size);
+	int received = 0;
+	Error err = stream->get_partial_data(w, size, received);
+	end += received;
+	return err == OK && received > 0;
+}
+
+JSONStreamParser::TokenStatus JSONStreamParser::_get_token(TokenType &r_type) {
+	const uint8_t *p = buffer.ptr();
+	while (pos < end) {
+		const uint8_t c = p[pos];
+		switch (c) {
+			case '{': {
+				r_type = TK_CURLY_BRACKET_OPEN;
+				pos++;
+				return TOKEN_OK;
+			}
+			case '}': {
+				r_type = TK_CURLY_BRACKET_CLOSE;
+				pos++;
+				return TOKEN_OK;
+			}
+			case '[': {
+				r_type = TK_BRACKET_OPEN;
+				pos++;
+				return TOKEN_OK;
+			}
+			case ']': {
+				r_type = TK_BRACKET_CLOSE;
+				pos++;
+				return TOKEN_OK;
+			}
+			case ':': {
+				r_type = TK_COLON;
+				pos++;
+				return TOKEN_OK;
+			}
+			case ',': {
+				r_type = TK_COMMA;
+				pos++;
+				return TOKEN_OK;
+			}
+			case '"': {
+				r_type = TK_STRING;
+				return _get_string();
+			}
+			default: {
+				if (c <= 32) {
+					if (c == '\n') {
+						line++;
+					}
+					pos++;
+					break;
+				}
+
+				if (c == '-' || is_digit(c)) {
+					r_type = TK_NUMBER;
+					return _get_number();
+				} else if (is_ascii_alphabet_char(c)) {
+					r_type = TK_IDENTIFIER;
+					return _get_identifier();
+				} else {
+					err_str = "Unexpected character.";
+					return TOKEN_ERROR;
+				}
+			}
+		}
+	}
+
+	if (input_finished) {
+		r_type = TK_EOF;
+		return TOKEN_OK;
+	}
+	return TOKEN_NEED_DATA;
+}
+
+JSONStreamParser::TokenStatus JSONStreamParser::_get_string() {
+	const uint8_t *p = buffer.ptr();
+
+	// Find the closing quote first, resuming where the last attempt stopped
+	// so long strings arriving in chunks are only scanned once.
+	int64_t i = pos + 1 + string_scan;
+	bool closed = false;
+	while (i < end) {
+		const uint8_t c = p[i];
+		if (c == '"') {
+			closed = true;
+			break;
+		} else if (c == '\\') {
+			if (i + 1 >= end) {
+				break;
+			}
+			string_escaped = true;
+			i += 2;
+		} else {
+			i++;
+		}
+	}
+
+	if (!closed) {
+		if (input_finished) {
+			err_str = "Unterminated String";
+			return TOKEN_ERROR;
+		}
+		string_scan = i - pos - 1;
+		return TOKEN_NEED_DATA;
+	}
+
+	const char *str = (const char *)p + pos + 1;
+	const int64_t len = i - pos - 1;
+	for (const char *nl = (const char *)memchr(str, '\n', len); nl; nl = (const char *)memchr(nl + 1, '\n', str + len - nl - 1)) {
+		line++;
+	}
+
+	if (!string_escaped) {
+		value = String::utf8(str, len);
+	} else {
+		string_buffer.clear();
+		for (int64_t j = 0; j < len; j++) {
+			if (str[j] != '\\') {
+				string_buffer.push_back(str[j]);
+				continue;
+			}
+
+			// Always followed by another character, see above.
+			j++;
+			switch (str[j]) {
+				case 'b': {
+					string_buffer.push_back(8);
+				} break;
+				case 't': {
+					string_buffer.push_back(9);
+				} break;
+				case 'n': {
+					string_buffer.push_back(10);
+				} break;
+				case 'f': {
+					string_buffer.push_back(12);
+				} break;
+				case 'r': {
+					string_buffer.push_back(13);
+				} break;
+				case '"':
+				case '\\':
+				case '/': {
+					string_buffer.push_back(str[j]);
+				} break;
+				case 'u': {
+					char32_t res;
+					if (!_parse_hex(str + j + 1, len - j - 1, res)) {
+						err_str = "Malformed hex constant in string";
+						return TOKEN_ERROR;
+					}
+					j += 4;
+
+					if ((res & 0xfffffc00) == 0xd800) {
+						char32_t trail;
+						if (j + 2 >= len || str[j + 1] != '\\' || str[j + 2] != 'u') {
+							err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+							return TOKEN_ERROR;
+						}
+						if (!_parse_hex(str + j + 3, len - j - 3, trail)) {
+							err_str = "Malformed hex constant in string";
+							return TOKEN_ERROR;
+						}
+						if ((trail & 0xfffffc00) != 0xdc00) {
+							err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+							return TOKEN_ERROR;
+						}
+						res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+						j += 6;
+					} else if ((res & 0xfffffc00) == 0xdc00) {
+						err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+						return TOKEN_ERROR;
+					}
+
+					_append_utf8(string_buffer, res);
+				} break;
+				default: {
+					err_str = "Invalid escape sequence.";
+					return TOKEN_ERROR;
+				}
+			}
+		}
+		value = String::utf8(string_buffer.ptr(), string_buffer.size());
+	}
+
+	pos = i + 1;
+	string_scan = 0;
+	string_escaped = false;
+	return TOKEN_OK;
+}
+
+JSONStreamParser::TokenStatus JSONStreamParser::_get_number() {
+	const uint8_t *p = buffer.ptr();
+	int64_t i = pos;
+	bool integer = true;
+	while (i < end) {
+		const uint8_t c = p[i];
+		if (is_digit(c) || c == '-' || c == '+') {
+			i++;
+		} else if (c == '.' || c == 'e' || c == 'E') {
+			integer = false;
+			i++;
+		} else {
+			break;
+		}
+	}
+	if (i == end && !input_finished) {
+		return TOKEN_NEED_DATA;
+	}
+
+	const char *str = (const char *)p + pos;
+	const int64_t len = i - pos;
+	const bool negative = str[0] == '-';
+	const int64_t digits = len - (negative ? 1 : 0);
+
+	if (integer && digits > 0 && digits <= 15) {
+		// Fast path, exactly representable as a double.
+		int64_t number = 0;
+		for (int64_t j = negative ? 1 : 0; j < len && is_digit(str[j]); j++) {
+			number = number * 10 + (str[j] - '0');
+		}
+		value = double(negative ? -number : number);
+	} else if (len < 64) {
+		char number[64];
+		memcpy(number, str, len);
+		number[len] = 0;
+		value = String::to_float(number);
+	} else {
+		CharString number;
+		number.resize(len + 1);
+		memcpy(number.ptrw(), str, len);
+		number.ptrw()[len] = 0;
+		value = String::to_float(number.get_data());
+	}
+
+	pos = i;
+	return TOKEN_OK;
+}
+
+JSONStreamParser::TokenStatus JSONStreamParser::_get_identifier() {
+	const uint8_t *p = buffer.ptr();
+	int64_t i = pos;
+	while (i < end && is_ascii_alphabet_char(p[i])) {
+		i++;
+	}
+	if (i == end && !input_finished) {
+		return TOKEN_NEED_DATA;
+	}
+
+	value = String::utf8((const char *)p + pos, i - pos);
+	pos = i;
+	return TOKEN_OK;
+}
+
+JSONStreamParser::Event JSONStreamParser::_set_error(const String &p_error) {
+	err_str = p_error;
+	state = STATE_ERROR;
+	value = Variant();
+	return EVENT_ERROR;
+}
+
+JSONStreamParser::Event JSONStreamParser::_parse_value_token(TokenType p_type) {
+	switch (p_type) {
+		case TK_CURLY_BRACKET_OPEN:
+		case TK_BRACKET_OPEN: {
+			if (containers.size() >= Variant::MAX_RECURSION_DEPTH) {
+				return _set_error("JSON structure is too deep. Bailing.");
+			}
+			const bool is_object = p_type == TK_CURLY_BRACKET_OPEN;
+			containers.push_back(is_object);
+			state = is_object ? STATE_OBJECT_FIRST : STATE_ARRAY_FIRST;
+			value = Variant();
+			return is_object ? EVENT_OBJECT_START : EVENT_ARRAY_START;
+		}
+		case TK_IDENTIFIER: {
+			const String id = value;
+			if (id == "true") {
+				value = true;
+			} else if (id == "false") {
+				value = false;
+			} else if (id == "null") {
+				value = Variant();
+			} else {
+				return _set_error("Expected 'true','false' or 'null', got '" + id + "'.");
+			}
+			state = STATE_AFTER_VALUE;
+			return EVENT_VALUE;
+		}
+		case TK_NUMBER:
+		case TK_STRING: {
+			state = STATE_AFTER_VALUE;
+			return EVENT_VALUE;
+		}
+		default: {
+			return _set_error("Expected value, got " + String(_json_token_names[p_type]) + ".");
+		}
+	}
+}
+
+JSONStreamParser::Event JSONStreamParser::_next_event() {
+	while (true) {
+		if (state == STATE_DONE) {
+			return EVENT_DONE;
+		} else if (state == STATE_ERROR) {
+			return EVENT_ERROR;
+		}
+
+		TokenType type = TK_EOF;
+		const TokenStatus status = _get_token(type);
+		if (status == TOKEN_NEED_DATA) {
+			// Even after the top-level value, anything but whitespace could still follow.
+			return EVENT_NEED_DATA;
+		} else if (status == TOKEN_ERROR) {
+			state = STATE_ERROR;
+			value = Variant();
+			return EVENT_ERROR;
+		}
+
+		switch (state) {
+			case STATE_VALUE: {
+				return _parse_value_token(type);
+			}
+			case STATE_ARRAY_FIRST: {
+				if (type == TK_BRACKET_CLOSE) {
+					containers.resize(containers.size() - 1);
+					state = STATE_AFTER_VALUE;
+					return EVENT_ARRAY_END;
+				}
+				return _parse_value_token(type);
+			}
+			case STATE_OBJECT_FIRST: {
+				if (type == TK_CURLY_BRACKET_CLOSE) {
+					containers.resize(containers.size() - 1);
+					state = STATE_AFTER_VALUE;
+					return EVENT_OBJECT_END;
+				}
+				[[fallthrough]];
+			}
+			case STATE_KEY: {
+				if (type != TK_STRING) {
+					return _set_error("Expected key");
+				}
+				state = STATE_COLON;
+				return EVENT_KEY;
+			}
+			case STATE_COLON: {
+				if (type != TK_COLON) {
+					return _set_error("Expected ':'");
+				}
+				state = STATE_VALUE;
+			} break;
+			case STATE_AFTER_VALUE: {
+				if (containers.is_empty()) {
+					if (type != TK_EOF) {
+						return _set_error("Expected 'EOF'");
+					}
+					state = STATE_DONE;
+					return EVENT_DONE;
+				}
+
+				const bool is_object = containers[containers.size() - 1];
+				if (type == TK_COMMA) {
+					state = is_object ? STATE_KEY : STATE_VALUE;
+				} else if (is_object && type == TK_CURLY_BRACKET_CLOSE) {
+					containers.resize(containers.size() - 1);
+					return EVENT_OBJECT_END;
+				} else if (!is_object && type == TK_BRACKET_CLOSE) {
+					containers.resize(containers.size() - 1);
+					return EVENT_ARRAY_END;
+				} else {
+					return _set_error(is_object ? "Expected '}' or ','" : "Expected ','");
+				}
+			} break;
+			default: {
+				ERR_FAIL_V(EVENT_ERROR);
+			}
+		}
+	}
+}
+
+void JSONStreamParser::_add_to_tree(const Variant &p_value) {
+	if (frames.is_empty()) {
+		data = p_value;
+		return;
+	}
+
+	Frame &frame = frames[frames.size() - 1];
+	if (frame.is_object) {
+		frame.dictionary[frame.key] = p_value;
+		return;
+	}
+
+	if (frame.packed) {
+		if (p_value.get_type() == Variant::FLOAT) {
+			frame.numbers.push_back(p_value);
+			return;
+		}
+
+		// Not only numbers, fall back to a regular array.
+		frame.packed = false;
+		frame.array.resize(frame.numbers.size());
+		for (uint32_t i = 0; i < frame.numbers.size(); i++) {
+			frame.array[i] = frame.numbers[i];
+		}
+		frame.numbers.reset();
+	}
+	frame.array.push_back(p_value);
+}
+
+void JSONStreamParser::set_stream(const Ref<StreamPeer> &p_stream) {
+	stream = p_stream;
+}
+
+Ref<StreamPeer> JSONStreamParser::get_stream() const {
+	return stream;
+}
+
+void JSONStreamParser::append_data(const PackedByteArray &p_data) {
+	ERR_FAIL_COND_MSG(input_finished, "Can't append data after finish_data() was called.");
+	if (pos == end) {
+		// Everything so far was consumed, parse straight from the given array.
+		buffer = p_data;
+		pos = 0;
+		end = p_data.size();
+		return;
+	}
+	append_buffer(p_data.ptr(), p_data.size());
+}
+
+void JSONStreamParser::append_buffer(const uint8_t *p_data, int64_t p_size) {
+	ERR_FAIL_COND_MSG(input_finished, "Can't append data after finish_data() was called.");
+	if (p_size <= 0) {
+		return;
+	}
+	memcpy(_reserve(p_size), p_data, p_size);
+	end += p_size;
+}
+
+void JSONStreamParser::finish_data() {
+	input_finished = true;
+}
+
+void JSONStreamParser::clear() {
+	buffer.clear();
+	pos = 0;
+	end = 0;
+	input_finished = false;
+	state = STATE_VALUE;
+	containers.clear();
+	value = Variant();
+	line = 0;
+	err_str = String();
+	string_scan = 0;
+	string_escaped = false;
+	string_buffer.clear();
+	frames.clear();
+	data = Variant();
+	data_done = false;
+}
+
+JSONStreamParser::Event JSONStreamParser::next_event() {
+	while (true) {
+		const Event event = _next_event();
+		if (event != EVENT_NEED_DATA || !_fill_from_stream()) {
+			return event;
+		}
+	}
+}
+
+Variant JSONStreamParser::get_value() const {
+	return value;
+}
+
+int JSONStreamParser::get_depth() const {
+	return containers.size();
+}
+
+void JSONStreamParser::set_use_packed_arrays(bool p_enabled) {
+	use_packed_arrays = p_enabled;
+}
+
+bool JSONStreamParser::is_using_packed_arrays() const {
+	return use_packed_arrays;
+}
+
+Error JSONStreamParser::parse(uint64_t p_max_usec) {
+	if (data_done) {
+		return OK;
+	}
+
+	const uint64_t start_usec = p_max_usec ? OS::get_singleton()->get_ticks_usec() : 0;
+	uint32_t events = 0;
+	while (true) {
+		switch (next_event()) {
+			case EVENT_NEED_DATA: {
+				return ERR_BUSY;
+			}
+			case EVENT_ERROR: {
+				return ERR_PARSE_ERROR;
+			}
+			case EVENT_DONE: {
+				data_done = true;
+				return OK;
+			}
+			case EVENT_OBJECT_START:
+			case EVENT_ARRAY_START: {
+				const bool is_object = containers[containers.size() - 1];
+				frames.push_back(Frame());
+				Frame &frame = frames[frames.size() - 1];
+				frame.is_object = is_object;
+				frame.packed = !is_object && use_packed_arrays;
+			} break;
+			case EVENT_KEY: {
+				ERR_FAIL_COND_V_MSG(frames.is_empty(), ERR_BUG, "parse() can't continue a document whose start was read with next_event().");
+				frames[frames.size() - 1].key = value;
+			} break;
+			case EVENT_VALUE: {
+				_add_to_tree(value);
+			} break;
+			case EVENT_OBJECT_END:
+			case EVENT_ARRAY_END: {
+				ERR_FAIL_COND_V_MSG(frames.is_empty(), ERR_BUG, "parse() can't continue a document whose start was read with next_event().");
+				Variant container;
+				Frame &frame = frames[frames.size() - 1];
+				if (frame.is_object) {
+					container = frame.dictionary;
+				} else if (frame.packed && !frame.numbers.is_empty()) {
+					PackedFloat64Array numbers;
+					numbers.resize(frame.numbers.size());
+					memcpy(numbers.ptrw(), frame.numbers.ptr(), frame.numbers.size() * sizeof(double));
+					container = numbers;
+				} else {
+					container = frame.array;
+				}
+				frames.resize(frames.size() - 1);
+				_add_to_tree(container);
+			} break;
+		}
+
+		if (p_max_usec && (++events & 1023) == 0 && OS::get_singleton()->get_ticks_usec() - start_usec >= p_max_usec) {
+			return ERR_BUSY;
+		}
+	}
+}
+
+Variant JSONStreamParser::get_data() const {
+	return data;
+}
+
+int JSONStreamParser::get_error_line() const {
+	return line;
+}
+
+String JSONStreamParser::get_error_message() const {
+	return err_str;
+}
+
+void JSONStreamParser::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_stream", "stream"), &JSONStreamParser::set_stream);
+	ClassDB::bind_method(D_METHOD("get_stream"), &JSONStreamParser::get_stream);
+	ClassDB::bind_method(D_METHOD("append_data", "data"), &JSONStreamParser::append_data);
+	ClassDB::bind_method(D_METHOD("finish_data"), &JSONStreamParser::finish_data);
+	ClassDB::bind_method(D_METHOD("clear"), &JSONStreamParser::clear);
+
+	ClassDB::bind_method(D_METHOD("next_event"), &JSONStreamParser::next_event);
+	ClassDB::bind_method(D_METHOD("get_value"), &JSONStreamParser::get_value);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JSONStreamParser::get_depth);
+
+	ClassDB::bind_method(D_METHOD("set_use_packed_arrays", "enabled"), &JSONStreamParser::set_use_packed_arrays);
+	ClassDB::bind_method(D_METHOD("is_using_packed_arrays"), &JSONStreamParser::is_using_packed_arrays);
+	ClassDB::bind_method(D_METHOD("parse", "max_usec"), &JSONStreamParser::parse, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_data"), &JSONStreamParser::get_data);
+
+	ClassDB::bind_method(D_METHOD("get_error_line"), &JSONStreamParser::get_error_line);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JSONStreamParser::get_error_message);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "stream", PROPERTY_HINT_RESOURCE_TYPE, "StreamPeer", PROPERTY_USAGE_NONE), "set_stream", "get_stream");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_packed_arrays"), "set_use_packed_arrays", "is_using_packed_arrays");
+
+	BIND_ENUM_CONSTANT(EVENT_NEED_DATA);
+	BIND_ENUM_CONSTANT(EVENT_OBJECT_START);
+	BIND_ENUM_CONSTANT(EVENT_OBJECT_END);
+	BIND_ENUM_CONSTANT(EVENT_ARRAY_START);
+	BIND_ENUM_CONSTANT(EVENT_ARRAY_END);
+	BIND_ENUM_CONSTANT(EVENT_KEY);
+	BIND_ENUM_CONSTANT(EVENT_VALUE);
+	BIND_ENUM_CONSTANT(EVENT_DONE);
+	BIND_ENUM_CONSTANT(EVENT_ERROR);
+}
@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  json_stream_parser.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_STREAM_PARSER_H
+#define JSON_STREAM_PARSER_H
+
+#include "core/io/stream_peer.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Incremental pull parser for UTF-8 encoded JSON. Input can be appended in
+// chunks or pulled from a StreamPeer, and parsing stops wherever the input
+// runs out, to be resumed once more arrives. Events can be pulled one by one,
+// or parse() builds the same Variant tree as JSON::parse() within a time budget.
+class JSONStreamParser : public RefCounted {
+	GDCLASS(JSONStreamParser, RefCounted);
+
+public:
+	enum Event {
+		EVENT_NEED_DATA,
+		EVENT_OBJECT_START,
+		EVENT_OBJECT_END,
+		EVENT_ARRAY_START,
+		EVENT_ARRAY_END,
+		EVENT_KEY,
+		EVENT_VALUE,
+		EVENT_DONE,
+		EVENT_ERROR,
+	};
+
+private:
+	enum TokenType {
+		TK_CURLY_BRACKET_OPEN,
+		TK_CURLY_BRACKET_CLOSE,
+		TK_BRACKET_OPEN,
+		TK_BRACKET_CLOSE,
+		TK_IDENTIFIER,
+		TK_STRING,
+		TK_NUMBER,
+		TK_COLON,
+		TK_COMMA,
+		TK_EOF,
+	};
+
+	enum State {
+		STATE_VALUE,
+		STATE_ARRAY_FIRST,
+		STATE_OBJECT_FIRST,
+		STATE_KEY,
+		STATE_COLON,
+		STATE_AFTER_VALUE,
+		STATE_DONE,
+		STATE_ERROR,
+	};
+
+	enum TokenStatus {
+		TOKEN_OK,
+		TOKEN_NEED_DATA,
+		TOKEN_ERROR,
+	};
+
+	static const int STREAM_CHUNK_SIZE = 256 * 1024;
+
+	PackedByteArray buffer; // Valid input is [pos, end), the rest is spare capacity.
+	int64_t pos = 0;
+	int64_t end = 0;
+	Ref<StreamPeer> stream;
+	bool input_finished = false;
+
+	State state = STATE_VALUE;
+	LocalVector<bool> containers; // True for objects.
+	Variant value;
+	int line = 0;
+	String err_str;
+
+	// Progress scanning a string token that isn't complete yet.
+	int64_t string_scan = 0;
+	bool string_escaped = false;
+	LocalVector<char> string_buffer;
+
+	// Tree building for parse().
+	struct Frame {
+		bool is_object = false;
+		bool packed = false;
+		Array array;
+		Dictionary dictionary;
+		LocalVector<double> numbers;
+		Variant key;
+	};
+	LocalVector<Frame> frames;
+	Variant data;
+	bool data_done = false;
+	bool use_packed_arrays = false;
+
+	uint8_t *_reserve(int64_t p_size);
+	bool _fill_from_stream();
+
+	TokenStatus _get_token(TokenType &r_type);
+	TokenStatus _get_string();
+	TokenStatus _get_number();
+	TokenStatus _get_identifier();
+	Event _set_error(const String &p_error);
+	Event _parse_value_token(TokenType p_type);
+	Event _next_event();
+
+	void _add_to_tree(const Variant &p_value);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_stream(const Ref<StreamPeer> &p_stream);
+	Ref<StreamPeer> get_stream() const;
+
+	void append_data(const PackedByteArray &p_data);
+	void append_buffer(const uint8_t *p_data, int64_t p_size);
+	void finish_data();
+	void clear();
+
+	Event next_event();
+	Variant get_value() const;
+	int get_depth() const;
+
+	void set_use_packed_arrays(bool p_enabled);
+	bool is_using_packed_arrays() const;
+
+	Error parse(uint64_t p_max_usec = 0);
+	Variant get_data() const;
+
+	int get_error_line() const;
+	String get_error_message() const;
+};
+
+VARIANT_ENUM_CAST(JSONStreamParser::Event);
+
+#endif // JSON_STREAM_PARSER_H
@@ -31,6 +31,7 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
@@ -51,6 +52,10 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("set_compress_files", "enabled"), &PCKPacker::set_compress_files);
+	ClassDB::bind_method(D_METHOD("is_compress_files_enabled"), &PCKPacker::is_compress_files_enabled);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compress_files"), "set_compress_files", "is_compress_files_enabled");
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -84,13 +89,16 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	}
 	enc_dir = p_encrypt_directory;
 
+	_remove_compressed_tmp();
+
 	file = FileAccess::open(p_pck_path, FileAccess::WRITE);
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, vformat("Can't open file to write: '%s'.", String(p_pck_path)));
 
+	pck_path = p_pck_path;
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	file->store_32(PACK_FORMAT_VERSION_UNCOMPRESSED); // Updated in flush() if files are compressed.
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
@@ -154,6 +162,22 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	pf.encrypted = p_encrypt;
 
 	uint64_t _size = pf.size;
+	if (compress_files) {
+		// Files that don't shrink enough are stored as is.
+		const Vector<uint8_t> compressed = FileAccessPack::compress_data(data.ptr(), data.size());
+		if (!compressed.is_empty()) {
+			if (compressed_tmp.is_null()) {
+				compressed_tmp_path = pck_path + ".tmp";
+				compressed_tmp = FileAccess::open(compressed_tmp_path, FileAccess::WRITE_READ);
+				ERR_FAIL_COND_V_MSG(compressed_tmp.is_null(), ERR_CANT_CREATE, vformat("Can't open file to write: '%s'.", compressed_tmp_path));
+			}
+			pf.compressed = true;
+			pf.compressed_ofs = compressed_tmp->get_position();
+			pf.compressed_size = compressed.size();
+			compressed_tmp->store_buffer(compressed.ptr(), compressed.size());
+			_size = pf.compressed_size;
+		}
+	}
 	if (p_encrypt) { // Add encryption overhead.
 		if (_size % 16) { // Pad to encryption block size.
 			_size += 16 - (_size % 16);
@@ -174,6 +198,14 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	if (compressed_tmp.is_valid()) {
+		// The header was written for the format version that can't hold compressed files.
+		int64_t pos = file->get_position();
+		file->seek(4);
+		file->store_32(PACK_FORMAT_VERSION);
+		file->seek(pos);
+	}
+
 	int64_t file_base_ofs = file->get_position();
 	file->store_64(0); // files base
 
@@ -218,6 +250,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -245,8 +280,16 @@ Error PCKPacker::flush(bool p_verbose) {
 			continue;
 		}
 
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
+		Ref<FileAccess> src;
+		uint64_t to_write = 0;
+		if (files[i].compressed) {
+			src = compressed_tmp;
+			src->seek(files[i].compressed_ofs);
+			to_write = files[i].compressed_size;
+		} else {
+			src = FileAccess::open(files[i].src_path, FileAccess::READ);
+			to_write = files[i].size;
+		}
 
 		Ref<FileAccess> ftmp = file;
 		if (files[i].encrypted) {
@@ -283,6 +326,26 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	file.unref();
 	memdelete_arr(buf);
+	_remove_compressed_tmp();
 
 	return OK;
 }
+
+void PCKPacker::_remove_compressed_tmp() {
+	if (compressed_tmp.is_valid()) {
+		compressed_tmp.unref();
+		DirAccess::remove_absolute(compressed_tmp_path);
+	}
+}
+
+void PCKPacker::set_compress_files(bool p_enabled) {
+	compress_files = p_enabled;
+}
+
+bool PCKPacker::is_compress_files_enabled() const {
+	return compress_files;
+}
+
+PCKPacker::~PCKPacker() {
+	_remove_compressed_tmp();
+}
@@ -39,11 +39,17 @@ class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
 
 	Ref<FileAccess> file;
+	String pck_path;
 	int alignment = 0;
 	uint64_t ofs = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	bool compress_files = false;
+
+	// Compressed files are written here as they are added, until flush().
+	Ref<FileAccess> compressed_tmp;
+	String compressed_tmp_path;
 
 	static void _bind_methods();
 
@@ -54,17 +60,26 @@ class PCKPacker : public RefCounted {
 		uint64_t size = 0;
 		bool encrypted = false;
 		bool removal = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
+		uint64_t compressed_ofs = 0;
+		uint64_t compressed_size = 0;
 	};
 	Vector<File> files;
 
+	void _remove_compressed_tmp();
+
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
+	void set_compress_files(bool p_enabled);
+	bool is_compress_files_enabled() const;
+
 	PCKPacker() {}
+	~PCKPacker();
 };
 
 #endif // PCK_PACKER_H
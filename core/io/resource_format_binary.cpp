@@ -157,21 +157,32 @@ StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
-		String s;
-		s.parse_utf8(&str_buf[0], len);
-		return s;
+		return _get_utf8_string(len);
 	}
 
 	return string_map[id];
 }
 
+String ResourceLoaderBinary::_get_utf8_string(uint32_t p_length) {
+	String s;
+	const uint8_t *view = f->get_buffer_view(p_length);
+	if (view) {
+		// Memory-mapped pack, decode in place without the intermediate copy.
+		s.parse_utf8((const char *)view, p_length);
+		return s;
+	}
+
+	if ((int)p_length > str_buf.size()) {
+		str_buf.resize(p_length);
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], p_length);
+	s.parse_utf8(&str_buf[0], p_length);
+	return s;
+}
+
 Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 	uint32_t prop_type = f->get_32();
 	print_bl("find property of type: " + itos(prop_type));
@@ -392,6 +403,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_OBJECT: {
 			uint32_t objtype = f->get_32();
+			if (objtype != OBJECT_EMPTY) {
+				parsed_objects++;
+			}
 
 			switch (objtype) {
 				case OBJECT_EMPTY: {
@@ -416,6 +430,11 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					} else {
 						r_v = internal_index_cache[path];
 					}
+
+					HashMap<String, PropertyTask *>::Iterator E = property_tasks.find(path);
+					if (E) {
+						parsed_dependencies.push_back(E->value);
+					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
 					//old file format, still around for compatibility
@@ -680,6 +699,95 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
+ResourceLoaderBinary::~ResourceLoaderBinary() {
+	// Only left over if loading failed midway.
+	_wait_for_property_tasks();
+}
+
+void ResourceLoaderBinary::_set_properties(const Ref<Resource> &p_resource, const LocalVector<Pair<StringName, Variant>> &p_properties, MissingResource *p_missing_resource) {
+	Dictionary missing_resource_properties;
+
+	for (const Pair<StringName, Variant> &property : p_properties) {
+		const StringName &name = property.first;
+		Variant value = property.second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && p_missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
+			}
+		}
+
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = p_resource->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+				}
+			}
+		}
+
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = p_resource->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
+				}
+			}
+		}
+
+		if (set_valid) {
+			p_resource->set(name, value);
+		}
+	}
+
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		p_resource->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
+
+#ifdef TOOLS_ENABLED
+	p_resource->set_edited(false);
+#endif
+}
+
+void ResourceLoaderBinary::_run_property_task(void *p_userdata) {
+	PropertyTask *task = (PropertyTask *)p_userdata;
+	_set_properties(task->resource, task->properties, nullptr);
+}
+
+void ResourceLoaderBinary::_wait_for_property_task(PropertyTask *p_task) {
+	if (p_task->task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_task->task_id);
+		p_task->task_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void ResourceLoaderBinary::_wait_for_property_tasks() {
+	for (KeyValue<String, PropertyTask *> &E : property_tasks) {
+		_wait_for_property_task(E.value);
+		memdelete(E.value);
+	}
+	property_tasks.clear();
+	parsed_dependencies.clear();
+}
+
 Error ResourceLoaderBinary::load() {
 	if (error != OK) {
 		return error;
@@ -752,6 +860,7 @@ Error ResourceLoaderBinary::load() {
 		Resource *r = nullptr;
 
 		MissingResource *missing_resource = nullptr;
+		bool created = false;
 
 		if (main) {
 			res = ResourceLoader::get_resource_ref_override(local_path);
@@ -793,6 +902,7 @@ Error ResourceLoaderBinary::load() {
 				}
 
 				res = Ref<Resource>(r);
+				created = true;
 			}
 		}
 
@@ -813,9 +923,12 @@ Error ResourceLoaderBinary::load() {
 
 		int pc = f->get_32();
 
-		//set properties
+		const uint64_t properties_offset = f->get_position();
+		const uint32_t objects_before = parsed_objects;
+		parsed_dependencies.clear();
 
-		Dictionary missing_resource_properties;
+		LocalVector<Pair<StringName, Variant>> properties;
+		properties.reserve(pc);
 
 		for (int j = 0; j < pc; j++) {
 			StringName name = _get_string();
@@ -832,61 +945,30 @@ Error ResourceLoaderBinary::load() {
 				return error;
 			}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
-
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+			properties.push_back(Pair<StringName, Variant>(name, value));
+		}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+		bool use_task = use_sub_threads && created && !main && !missing_resource && parsed_objects == objects_before;
+		use_task = use_task && f->get_position() - properties_offset >= PROPERTY_TASK_MIN_SIZE && !Object::cast_to<Script>(r);
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
+		if (use_task) {
+			PropertyTask *task = memnew(PropertyTask);
+			task->resource = res;
+			task->properties = properties;
+			property_tasks.insert(path, task);
+			task->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoaderBinary::_run_property_task, task);
+		} else {
+			if (main) {
+				// Everything must be complete before the main resource (e.g. a PackedScene) is assembled.
+				_wait_for_property_tasks();
+			} else {
+				for (PropertyTask *task : parsed_dependencies) {
+					_wait_for_property_task(task);
 				}
 			}
-
-			if (set_valid) {
-				res->set(name, value);
-			}
-		}
-
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
-		}
-
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+			_set_properties(res, properties, missing_resource);
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
-
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
@@ -927,16 +1009,10 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0) {
+	if (len <= 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
-	s.parse_utf8(&str_buf[0], len);
-	return s;
+	return _get_utf8_string(len);
 }
 
 void ResourceLoaderBinary::get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes) {
@@ -34,6 +34,11 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -55,6 +60,7 @@ class ResourceLoaderBinary {
 	Vector<StringName> string_map;
 
 	StringName _get_string();
+	String _get_utf8_string(uint32_t p_length);
 
 	struct ExtResource {
 		String path;
@@ -93,6 +99,27 @@ class ResourceLoaderBinary {
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	// When loading with sub-threads, internal resources that don't reference any
+	// other object and carry a large payload (meshes, images, shapes, animations...)
+	// get their properties set on the WorkerThreadPool. Resources referencing them
+	// wait for their task first, and the main resource waits for all of them.
+	static constexpr uint64_t PROPERTY_TASK_MIN_SIZE = 64 * 1024;
+
+	struct PropertyTask {
+		Ref<Resource> resource;
+		LocalVector<Pair<StringName, Variant>> properties;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	HashMap<String, PropertyTask *> property_tasks;
+	LocalVector<PropertyTask *> parsed_dependencies;
+	uint32_t parsed_objects = 0;
+
+	static void _run_property_task(void *p_userdata);
+	static void _set_properties(const Ref<Resource> &p_resource, const LocalVector<Pair<StringName, Variant>> &p_properties, MissingResource *p_missing_resource);
+	void _wait_for_property_task(PropertyTask *p_task);
+	void _wait_for_property_tasks();
+
 public:
 	Ref<Resource> get_resource();
 	Error load();
@@ -106,6 +133,7 @@ public:
 	void get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes);
 
 	ResourceLoaderBinary() {}
+	~ResourceLoaderBinary();
 };
 
 class ResourceFormatLoaderBinary : public ResourceFormatLoader {
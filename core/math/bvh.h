@@ -306,6 +306,20 @@ public:
 #endif
 	}
 
+	// Must call p_task(p_task_userdata, i) for every i in [0, p_count), possibly in parallel, and return once all are done.
+	typedef void (*ParallelForFunc)(void (*p_task)(void *, uint32_t), void *p_task_userdata, uint32_t p_count);
+
+	// Same as update(), but the tree queries for the changed items are split into up to p_thread_count tasks run by p_parallel_for.
+	// Pairing callbacks are still sent from the calling thread, and in the same order as in update().
+	void update_threaded(ParallelForFunc p_parallel_for, uint32_t p_thread_count) {
+		BVH_LOCKED_FUNCTION
+		tree.update();
+		_check_for_collisions_threaded(p_parallel_for, p_thread_count);
+#ifdef BVH_INTEGRITY_CHECKS
+		tree._integrity_check_all();
+#endif
+	}
+
 	// this can be called more frequently than per frame if necessary
 	void update_collisions() {
 		BVH_LOCKED_FUNCTION
@@ -480,6 +494,80 @@ private:
 		_reset();
 	}
 
+	// Culling the tree doesn't depend on the current pairs, so it can be done for all the changed items
+	// in parallel. The results are then used to find leavers and enterers serially, in the same order.
+	void _check_for_collisions_threaded(ParallelForFunc p_parallel_for, uint32_t p_thread_count) {
+		const uint32_t item_count = changed_items.size();
+		if (item_count < THREADED_PAIRING_MIN_ITEMS_PER_TASK * 2 || p_thread_count < 2) {
+			_check_for_collisions();
+			return;
+		}
+
+		const uint32_t task_count = MIN(p_thread_count, item_count / THREADED_PAIRING_MIN_ITEMS_PER_TASK);
+		if (_pairing_tasks.size() < task_count) {
+			_pairing_tasks.resize(task_count);
+		}
+		_pairing_task_count = task_count;
+
+		p_parallel_for(&BVH_Manager::_pairing_cull_task, this, task_count);
+
+		for (uint32_t t = 0; t < task_count; t++) {
+			const PairingTask &task = _pairing_tasks[t];
+			const uint32_t from = item_count * t / task_count;
+
+			uint32_t hit = 0;
+			for (uint32_t i = 0; i < task.hit_ends.size(); i++) {
+				const BVHHandle &h = changed_items[from + i];
+
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[h.id()].expanded_aabb);
+				_find_leavers(h, abb, false);
+
+				for (; hit < task.hit_ends[i]; hit++) {
+					uint32_t ref_id = task.hits[hit];
+					// don't collide against ourself
+					if (ref_id == h.id()) {
+						continue;
+					}
+
+					BVHHandle h_collidee;
+					h_collidee.set_id(ref_id);
+					_collide(h, h_collidee);
+				}
+			}
+		}
+		_reset();
+	}
+
+	static void _pairing_cull_task(void *p_self, uint32_t p_task) {
+		BVH_Manager *self = (BVH_Manager *)p_self;
+		self->_pairing_cull(p_task, self->_pairing_task_count);
+	}
+
+	void _pairing_cull(uint32_t p_task, uint32_t p_task_count) {
+		PairingTask &task = _pairing_tasks[p_task];
+		task.hits.clear();
+		task.hit_ends.clear();
+
+		const uint32_t item_count = changed_items.size();
+		const uint32_t from = item_count * p_task / p_task_count;
+		const uint32_t to = item_count * (p_task + 1) / p_task_count;
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		for (uint32_t i = from; i < to; i++) {
+			const BVHHandle &h = changed_items[i];
+			tree.item_fill_cullparams(h, params);
+			params.abb.from(tree._pairs[h.id()].expanded_aabb);
+			tree.cull_aabb_to(params, task.hits);
+			task.hit_ends.push_back(task.hits.size());
+		}
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +861,15 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Used by update_threaded(), kept to reuse allocations from tick to tick.
+	static const uint32_t THREADED_PAIRING_MIN_ITEMS_PER_TASK = 64;
+	struct PairingTask {
+		LocalVector<uint32_t, uint32_t, true> hits; // Tree hits of all the items handled by the task.
+		LocalVector<uint32_t, uint32_t, true> hit_ends; // One past the last hit of each item.
+	};
+	LocalVector<PairingTask> _pairing_tasks;
+	uint32_t _pairing_task_count = 0;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
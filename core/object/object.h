@@ -605,9 +605,19 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		struct Target {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		// Snapshot of the slots, rebuilt when they change. Emitting only takes a
+		// reference to it, which keeps it alive even if slots are disconnected.
+		Vector<Target> targets;
 		bool removable = false;
+
+		void update_targets();
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -85,6 +85,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	LocalVector<Task *> ready_dependents;
+
 	if (p_task->group) {
 		// Handling a group
 		bool do_post = false;
@@ -116,8 +118,14 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
+			{
+				// Completion is flagged under the lock so no dependent can be added after dependents are released.
+				// They are posted at the end, like those of single tasks.
+				MutexLock task_lock(task_mutex);
+				p_task->group->completed.set_to(true);
+				_collect_ready_dependents(p_task->group->dependents, ready_dependents);
+			}
 			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -145,6 +153,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		_collect_ready_dependents(p_task->dependents, ready_dependents);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -176,13 +185,25 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (ready_dependents.size()) {
+		MutexLock task_lock(task_mutex);
+		_post_ready_dependents(ready_dependents, task_lock);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 
 	while (true) {
-		Task *task_to_process = nullptr;
+		// Tasks in local queues can be taken without going through the shared mutex,
+		// unless the runlevel changed and has to be handled first.
+		Task *task_to_process = likely(!singleton->runlevel_changed.is_set()) ? singleton->_pop_local_task(thread_data, true) : nullptr;
+		if (task_to_process) {
+			singleton->_process_task(task_to_process);
+			continue;
+		}
+
 		{
 			MutexLock lock(singleton->task_mutex);
 
@@ -193,10 +214,8 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 			thread_data->signaled = false;
 
-			if (singleton->task_queue.first()) {
-				task_to_process = singleton->task_queue.first()->self();
-				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
+			task_to_process = singleton->_pop_task(thread_data);
+			if (!task_to_process) {
 				thread_data->cond_var.wait(lock);
 			}
 		}
@@ -207,6 +226,59 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task(ThreadData *p_thread_data) {
+	// Own tasks first, then shared ones, and only then those of other threads.
+	Task *task = _pop_local_task(p_thread_data, false);
+	if (task) {
+		return task;
+	}
+	SelfList<Task> *E = task_queue.first();
+	if (E) {
+		E->remove_from_list();
+		return E->self();
+	}
+	return _pop_local_task(p_thread_data, true);
+}
+
+// Only needs the local queue mutexes, so it can be called with or without holding task_mutex.
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_task(ThreadData *p_thread_data, bool p_steal) {
+	if (!local_queued_tasks.get()) {
+		return nullptr;
+	}
+
+	{
+		// Nested tasks are taken newest first, so their data is likely still hot in cache.
+		// Tasks posted from other threads are taken in the order they were posted.
+		MutexLock lock(p_thread_data->local_queue_mutex);
+		SelfList<Task> *E = p_thread_data->local_queue.last();
+		if (E && !E->self()->posted_by_queue_owner) {
+			E = p_thread_data->local_queue.first();
+		}
+		if (E) {
+			E->remove_from_list();
+			local_queued_tasks.decrement();
+			return E->self();
+		}
+	}
+
+	if (p_steal) {
+		// Steal the oldest task of another thread, holding only that thread's lock.
+		uint32_t thread_count = threads.size();
+		for (uint32_t i = 1; i < thread_count && local_queued_tasks.get(); i++) {
+			ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+			MutexLock lock(victim.local_queue_mutex);
+			SelfList<Task> *E = victim.local_queue.first();
+			if (E) {
+				E->remove_from_list();
+				local_queued_tasks.decrement();
+				return E->self();
+			}
+		}
+	}
+
+	return nullptr;
+}
+
 void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
@@ -230,10 +302,25 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// In work-stealing mode, tasks spawned from pool threads stay local to them unless stolen.
+	// Tasks posted from other threads are spread across all the local queues.
+	uint32_t thread_count = threads.size();
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (work_stealing) {
+				ThreadData &target = caller_pool_thread ? *caller_pool_thread : threads[local_post_index];
+				if (!caller_pool_thread) {
+					local_post_index = (local_post_index + 1) % thread_count;
+				}
+				p_tasks[i]->posted_by_queue_owner = caller_pool_thread != nullptr;
+				MutexLock queue_lock(target.local_queue_mutex);
+				target.local_queue.add_last(&p_tasks[i]->task_elem);
+				local_queued_tasks.increment();
+			} else {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -324,11 +411,57 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+uint32_t WorkerThreadPool::_add_dependencies(Task *p_task, const Vector<TaskID> &p_dependencies) {
+	// Task and group IDs share the same sequence. An ID that was handed out but can't be found anymore
+	// belongs to a task or group that has been completed and awaited already, so it's satisfied.
+	uint32_t pending = 0;
+	for (const TaskID &id : p_dependencies) {
+		Task **taskp = tasks.getptr(id);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				(*taskp)->dependents.push_back(p_task);
+				pending++;
+			}
+			continue;
+		}
+		Group **groupp = groups.getptr(id);
+		if (groupp) {
+			if (!(*groupp)->completed.is_set()) {
+				(*groupp)->dependents.push_back(p_task);
+				pending++;
+			}
+			continue;
+		}
+		ERR_CONTINUE_MSG(id < 1 || (uint64_t)id >= last_task, vformat("Invalid Task or Group ID %d used as dependency.", id));
+	}
+	p_task->pending_dependencies = pending;
+	return pending;
+}
+
+void WorkerThreadPool::_collect_ready_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready) {
+	for (Task *dependent : p_dependents) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			r_ready.push_back(dependent);
+		}
+	}
+	p_dependents.clear();
+}
+
+void WorkerThreadPool::_post_ready_dependents(const LocalVector<Task *> &p_ready, MutexLock<BinaryMutex> &p_lock) {
+	for (Task *task : p_ready) {
+		Task *task_to_post = task;
+		// Priority was decided when the task was added.
+		_post_tasks(&task_to_post, 1, !task->low_priority, p_lock);
+	}
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -340,9 +473,12 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->low_priority = !p_high_priority;
 	tasks.insert(id, task);
 
-	_post_tasks(&task, 1, p_high_priority, lock);
+	if (p_dependencies.is_empty() || _add_dependencies(task, p_dependencies) == 0) {
+		_post_tasks(&task, 1, p_high_priority, lock);
+	}
 
 	return id;
 }
@@ -351,6 +487,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -479,7 +623,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = _is_any_task_queued() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -497,11 +641,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (singleton->task_queue.first()) {
-				task_to_process = task_queue.first()->self();
-				task_queue.remove(task_queue.first());
-			}
-
+			task_to_process = _pop_task(p_caller_pool_thread);
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
 
@@ -527,6 +667,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 void WorkerThreadPool::_switch_runlevel(Runlevel p_runlevel) {
 	DEV_ASSERT(p_runlevel > runlevel);
 	runlevel = p_runlevel;
+	runlevel_changed.set();
 	memset(&runlevel_data, 0, sizeof(runlevel_data));
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].cond_var.notify_one();
@@ -543,7 +684,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!_is_any_task_queued() && !low_priority_task_queue.first()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -606,7 +747,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -622,6 +763,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
+		// Dependencies are ignored, since there's no work to hold back.
 		group->completed.set_to(true);
 		group->done_semaphore.post();
 		group->tasks_used = 0;
@@ -641,9 +783,22 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->low_priority = !p_high_priority;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
+
+		// Each of the tasks is held back until the dependencies are met. Since this happens under
+		// the lock, either all of them are or none of them is.
+		if (!p_dependencies.is_empty()) {
+			bool held_back = false;
+			for (int i = 0; i < p_tasks; i++) {
+				held_back = _add_dependencies(tasks_posted[i], p_dependencies) > 0;
+			}
+			if (held_back) {
+				p_tasks = 0; // Nothing to post now.
+			}
+		}
 	}
 
 	groups[id] = group;
@@ -661,6 +816,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -694,6 +857,12 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		group->done_semaphore.wait();
 		_lock_unlockable_mutexes();
 
+		{
+			// Unregister before the group may be freed, so dependency lookups never find a dangling pointer.
+			MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+			groups.erase(p_group);
+		}
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -703,12 +872,20 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			group_allocator.free(group);
 		}
 	}
-
-	MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
 #endif
 }
 
+void WorkerThreadPool::set_work_stealing_enabled(bool p_enabled) {
+	MutexLock task_lock(task_mutex);
+	// Tasks already in local queues will still be picked up or stolen, so this can be switched at any time.
+	work_stealing = p_enabled;
+}
+
+bool WorkerThreadPool::is_work_stealing_enabled() const {
+	MutexLock task_lock(task_mutex);
+	return work_stealing;
+}
+
 int WorkerThreadPool::get_thread_index() {
 	Thread::ID tid = Thread::get_caller_id();
 	return singleton->thread_ids.has(tid) ? singleton->thread_ids[tid] : -1;
@@ -749,10 +926,14 @@ void WorkerThreadPool::thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {
 }
 #endif
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, bool p_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 
 	runlevel = RUNLEVEL_NORMAL;
+	runlevel_changed.clear();
+	work_stealing = p_work_stealing;
+	local_queued_tasks.set(0);
+	local_post_index = 0;
 
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
@@ -760,7 +941,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
 
-	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
+	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority%s.", p_thread_count, max_low_priority_threads, work_stealing ? ", work stealing" : ""));
 
 	threads.resize(p_thread_count);
 
@@ -825,11 +1006,13 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 }
 
 WorkerThreadPool::WorkerThreadPool() {
@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*  frame_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_allocator.h"
+
+thread_local FrameAllocator::ThreadArenas FrameAllocator::thread_arenas;
+SafeNumeric<uint64_t> FrameAllocator::frame;
+SafeNumeric<uint64_t> FrameAllocator::allocations;
+SafeNumeric<uint64_t> FrameAllocator::reserved;
+
+uint64_t FrameAllocator::last_malloc_count = 0;
+uint64_t FrameAllocator::last_arena_allocations = 0;
+uint64_t FrameAllocator::malloc_calls_per_frame = 0;
+uint64_t FrameAllocator::arena_allocations_per_frame = 0;
+
+FrameAllocator::ThreadArenas::~ThreadArenas() {
+	for (Arena &arena : arenas) {
+		_free_chunks(arena);
+	}
+}
+
+void FrameAllocator::_free_chunks(Arena &p_arena) {
+	while (p_arena.chunks) {
+		Chunk *next = p_arena.chunks->next;
+		reserved.sub(p_arena.chunks->size);
+		Memory::free_static(p_arena.chunks);
+		p_arena.chunks = next;
+	}
+	p_arena.ptr = nullptr;
+	p_arena.end = nullptr;
+	p_arena.last = nullptr;
+}
+
+void FrameAllocator::_recycle(Arena &p_arena, uint64_t p_frame) {
+	// Counters are only published here to keep the allocation path free of atomics.
+	if (p_arena.allocations) {
+		allocations.add(p_arena.allocations);
+		p_arena.allocations = 0;
+	}
+
+	if (p_arena.chunks && p_arena.chunks->next) {
+		// The last frame this arena was used in needed several chunks. Replace
+		// them with a single one large enough for all of it, so the next frames
+		// fit without allocating.
+		size_t total = 0;
+		for (Chunk *c = p_arena.chunks; c; c = c->next) {
+			total += c->size;
+		}
+		_free_chunks(p_arena);
+
+		Chunk *chunk = (Chunk *)Memory::alloc_static(_align(sizeof(Chunk)) + total);
+		CRASH_COND_MSG(!chunk, "Out of memory");
+		chunk->next = nullptr;
+		chunk->size = total;
+		reserved.add(total);
+		p_arena.chunks = chunk;
+	}
+
+	if (p_arena.chunks) {
+		p_arena.ptr = _chunk_data(p_arena.chunks);
+		p_arena.end = p_arena.ptr + p_arena.chunks->size;
+	}
+	p_arena.last = nullptr;
+	p_arena.frame = p_frame;
+}
+
+void *FrameAllocator::_alloc_slow(Arena &p_arena, size_t p_bytes) {
+	size_t size = MAX(p_bytes, MIN_CHUNK_SIZE);
+	if (p_arena.chunks) {
+		size = MAX(size, p_arena.chunks->size * 2);
+	}
+
+	Chunk *chunk = (Chunk *)Memory::alloc_static(_align(sizeof(Chunk)) + size);
+	CRASH_COND_MSG(!chunk, "Out of memory");
+	chunk->next = p_arena.chunks;
+	chunk->size = size;
+	reserved.add(size);
+	p_arena.chunks = chunk;
+
+	p_arena.ptr = _chunk_data(chunk) + p_bytes;
+	p_arena.end = _chunk_data(chunk) + size;
+	p_arena.last = _chunk_data(chunk);
+	p_arena.allocations++;
+	return p_arena.last;
+}
+
+void *FrameAllocator::realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+
+	Arena &arena = _get_arena();
+	if (p_ptr == arena.last) {
+		// Most recent allocation, typically a growing vector: extend in place.
+		const size_t bytes = _align(p_bytes);
+		if (bytes <= size_t(arena.end - arena.last)) {
+			arena.ptr = arena.last + bytes;
+			return p_ptr;
+		}
+	}
+
+	void *ret = alloc(p_bytes);
+	memcpy(ret, p_ptr, MIN(p_old_bytes, p_bytes));
+	return ret;
+}
+
+void FrameAllocator::end_frame() {
+	const uint64_t malloc_count = Memory::get_alloc_count();
+	malloc_calls_per_frame = malloc_count - last_malloc_count;
+	last_malloc_count = malloc_count;
+
+	// Arenas publish their counts when recycled, so this lags up to two frames
+	// behind for other threads; fine for monitoring.
+	const uint64_t arena_allocations = allocations.get();
+	arena_allocations_per_frame = arena_allocations - last_arena_allocations;
+	last_arena_allocations = arena_allocations;
+
+	frame.increment();
+}
+
+void FrameAllocator::free_thread_arenas() {
+	for (Arena &arena : thread_arenas.arenas) {
+		if (arena.allocations) {
+			allocations.add(arena.allocations);
+			arena.allocations = 0;
+		}
+		_free_chunks(arena);
+		arena.frame = UINT64_MAX;
+	}
+}
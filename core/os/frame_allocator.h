@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  frame_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+
+// Bump allocator for short-lived temporaries in per-frame code (culling,
+// draw command building, animation blending...). Each thread allocates from
+// its own arena without locking, nothing is freed individually, and arenas are
+// recycled as frames go by, so a steady frame loop does no malloc at all.
+//
+// Memory is valid until the end of the frame after the one it was allocated
+// in; the extra frame covers the rendering thread running one frame behind.
+// Don't use it for anything that can outlive that, e.g. in background loading
+// tasks.
+class FrameAllocator {
+	static constexpr size_t ALIGNMENT = alignof(max_align_t);
+	static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+	struct Chunk {
+		Chunk *next = nullptr;
+		size_t size = 0; // Usable bytes, following the header.
+	};
+
+	struct Arena {
+		Chunk *chunks = nullptr; // Most recent first.
+		uint8_t *ptr = nullptr;
+		uint8_t *end = nullptr;
+		uint8_t *last = nullptr; // Last allocation, can grow in place.
+		uint64_t frame = UINT64_MAX;
+		uint64_t allocations = 0;
+	};
+
+	// Two arenas per thread, used on alternate frames.
+	struct ThreadArenas {
+		Arena arenas[2];
+		~ThreadArenas();
+	};
+
+	static thread_local ThreadArenas thread_arenas;
+	static SafeNumeric<uint64_t> frame;
+	static SafeNumeric<uint64_t> allocations;
+	static SafeNumeric<uint64_t> reserved;
+
+	static uint64_t last_malloc_count;
+	static uint64_t last_arena_allocations;
+	static uint64_t malloc_calls_per_frame;
+	static uint64_t arena_allocations_per_frame;
+
+	static _FORCE_INLINE_ size_t _align(size_t p_bytes) { return (p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+	static _FORCE_INLINE_ uint8_t *_chunk_data(Chunk *p_chunk) { return (uint8_t *)p_chunk + _align(sizeof(Chunk)); }
+
+	static _FORCE_INLINE_ Arena &_get_arena() {
+		const uint64_t current = frame.get();
+		Arena &arena = thread_arenas.arenas[current & 1];
+		if (unlikely(arena.frame != current)) {
+			_recycle(arena, current);
+		}
+		return arena;
+	}
+
+	static void _recycle(Arena &p_arena, uint64_t p_frame);
+	static void *_alloc_slow(Arena &p_arena, size_t p_bytes);
+	static void _free_chunks(Arena &p_arena);
+
+public:
+	static _FORCE_INLINE_ void *alloc(size_t p_bytes) {
+		Arena &arena = _get_arena();
+		const size_t bytes = _align(p_bytes);
+		if (unlikely(bytes > size_t(arena.end - arena.ptr))) {
+			return _alloc_slow(arena, bytes);
+		}
+		arena.last = arena.ptr;
+		arena.ptr += bytes;
+		arena.allocations++;
+		return arena.last;
+	}
+
+	static void *realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes);
+	static _FORCE_INLINE_ void free(void *p_ptr) {}
+
+	// Called by the main loop once a frame is done.
+	static void end_frame();
+	// Releases the arenas of the calling thread, other threads release theirs when they exit.
+	static void free_thread_arenas();
+
+	static uint64_t get_malloc_calls_per_frame() { return malloc_calls_per_frame; }
+	static uint64_t get_arena_allocations_per_frame() { return arena_allocations_per_frame; }
+	static uint64_t get_reserved_memory() { return reserved.get(); }
+};
+
+// LocalVector for per-frame temporaries, see FrameAllocator.
+template <typename T, typename U = uint32_t, bool force_trivial = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, false, FrameAllocator>;
+
+#endif // FRAME_ALLOCATOR_H
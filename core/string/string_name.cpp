@@ -33,6 +33,8 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
+#include <thread>
+
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
 	scs.ptr = p_ptr;
@@ -70,7 +72,7 @@ StringName _scs_create(const char *p_chr, bool p_static) {
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+		_table[i].set(nullptr);
 	}
 	configured = true;
 }
@@ -82,10 +84,10 @@ void StringName::cleanup() {
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
+			_Data *d = _table[i].get();
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.get();
 			}
 		}
 
@@ -95,10 +97,11 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			const uint32_t references = data[i]->debug_references.get();
+			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(references));
+			if (references == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (references < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -109,8 +112,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
+		while (_table[i].get()) {
+			_Data *d = _table[i].get();
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -121,21 +124,142 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_table[i].set(d->next.get());
 			memdelete(d);
 		}
 	}
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+		MutexLock shard_lock(_shards[i].mutex);
+		_free_graveyard(_shards[i]);
+	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
 }
 
+uint32_t StringName::_begin_lookup(_Shard &p_shard) {
+	while (true) {
+		const uint32_t generation = p_shard.generation.get();
+		p_shard.readers[generation].increment();
+		// Orders the count before reading the table, see _free_graveyard().
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (likely(p_shard.generation.get() == generation)) {
+			return generation;
+		}
+		// A removal switched generations meanwhile and may not wait for this one.
+		p_shard.readers[generation].decrement();
+	}
+}
+
+void StringName::_free_graveyard(_Shard &p_shard) {
+	// Names in the graveyard are already unlinked. Only lookups which counted
+	// themselves before this point may still be reading them.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const uint32_t generation = p_shard.generation.get();
+	if (p_shard.readers[generation].get() != 0 || p_shard.readers[generation ^ 1].get() != 0) {
+		if (p_shard.graveyard_size < STRING_GRAVEYARD_MAX) {
+			// A lookup may still be reading them, retry on the next removal.
+			return;
+		}
+
+		// New lookups count in the other generation. The previous switch already
+		// waited for the lookups there, so only the current ones are left.
+		p_shard.generation.set(generation ^ 1);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		while (p_shard.readers[generation].get() != 0) {
+			std::this_thread::yield();
+		}
+	}
+
+	// Lookups starting from now can't reach these anymore.
+	while (p_shard.graveyard) {
+		_Data *d = p_shard.graveyard;
+		p_shard.graveyard = d->prev;
+		memdelete(d);
+	}
+	p_shard.graveyard_size = 0;
+}
+
+template <typename T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash) {
+	_Shard &shard = _get_shard(p_hash);
+	const uint32_t generation = _begin_lookup(shard);
+
+	_Data *data = _table[p_hash & STRING_TABLE_MASK].get();
+	while (data) {
+		// Compare hash first. Names being removed can't be referenced again.
+		if (data->hash == p_hash && data->operator==(p_name) && data->refcount.ref()) {
+			break;
+		}
+		data = data->next.get();
+	}
+
+	shard.readers[generation].decrement();
+	return data;
+}
+
+template <typename T>
+StringName::_Data *StringName::_intern(const T &p_name, uint32_t p_hash, const char *p_cname, bool p_static) {
+	_Data *data = _find(p_name, p_hash);
+
+	if (unlikely(!data)) {
+		MutexLock lock(_get_shard(p_hash).mutex);
+
+		// Another thread may have added it before the lock was taken.
+		data = _find(p_name, p_hash);
+		if (!data) {
+			const uint32_t idx = p_hash & STRING_TABLE_MASK;
+
+			data = memnew(_Data);
+			if (p_cname) {
+				data->cname = p_cname;
+			} else {
+				data->name = p_name;
+			}
+			data->refcount.init();
+			data->static_count.set(p_static ? 1 : 0);
+			data->hash = p_hash;
+			data->idx = idx;
+			data->prev = nullptr;
+
+#ifdef DEBUG_ENABLED
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				data->refcount.ref();
+				data->static_count.increment();
+			}
+#endif
+
+			_Data *head = _table[idx].get();
+			data->next.set(head);
+			if (head) {
+				head->prev = data;
+			}
+			// Publish it only once it's fully initialized.
+			_table[idx].set(data);
+			return data;
+		}
+	}
+
+	// Exists.
+	if (p_static) {
+		data->static_count.increment();
+	}
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		data->debug_references.increment();
+	}
+#endif
+	return data;
+}
+
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+		_Shard &shard = _get_shard(_data->hash);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
@@ -144,19 +268,25 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+		_Data *next = _data->next.get();
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.set(next);
 		} else {
-			if (_table[_data->idx] != _data) {
+			if (_table[_data->idx].get() != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			_table[_data->idx].set(next);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		memdelete(_data);
+
+		// Keep `next` intact, a lookup may be on this node and still has to walk past it.
+		_data->prev = shard.graveyard;
+		shard.graveyard = _data;
+		shard.graveyard_size++;
+		_free_graveyard(shard);
 	}
 
 	_data = nullptr;
@@ -269,56 +399,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_name, String::hash(p_name), nullptr, p_static);
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -328,55 +409,7 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_static_string.ptr)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_static_string.ptr, String::hash(p_static_string.ptr), p_static_string.ptr, p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -388,54 +421,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_name, p_name.hash(), nullptr, p_static);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -446,25 +432,11 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
+	_Data *_data = _find(p_name, String::hash(p_name));
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 
@@ -482,23 +454,8 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
+	_Data *_data = _find(p_name, String::hash(p_name));
+	if (_data) {
 		return StringName(_data);
 	}
 
@@ -508,26 +465,11 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
+	_Data *_data = _find(p_name, p_name.hash());
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 		return StringName(_data);
@@ -48,7 +48,11 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARDS = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARDS - 1,
+		STRING_GRAVEYARD_MAX = 64,
 	};
 
 	struct _Data {
@@ -57,7 +61,7 @@ class StringName {
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
 		bool operator==(const String &p_name) const;
@@ -67,12 +71,29 @@ class StringName {
 
 		int idx = 0;
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		_Data *prev = nullptr; // Only used with the shard locked, links the graveyard once removed.
+		SafeNumeric<_Data *> next;
 		_Data() {}
 	};
 
-	static inline _Data *_table[STRING_TABLE_LEN];
+	// Lookups walk the buckets without locking. Adding or removing a name locks
+	// the shard of its bucket. Removed names wait in the shard's graveyard until
+	// no lookup which may still be reading them is running. Lookups count in the
+	// readers of the current generation, so once the graveyard is full, a removal
+	// can switch generations and wait only for the lookups already running.
+	struct alignas(64) _Shard {
+		Mutex mutex;
+		SafeNumeric<uint32_t> generation;
+		SafeNumeric<uint32_t> readers[2];
+		_Data *graveyard;
+		uint32_t graveyard_size;
+
+		_Shard() :
+				graveyard(nullptr), graveyard_size(0) {}
+	};
+
+	static inline SafeNumeric<_Data *> _table[STRING_TABLE_LEN];
+	static inline _Shard _shards[STRING_TABLE_SHARDS];
 
 	_Data *_data = nullptr;
 
@@ -88,13 +109,21 @@ class StringName {
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
 	static inline bool debug_stringname = false;
 #endif
 
+	_FORCE_INLINE_ static _Shard &_get_shard(uint32_t p_hash) { return _shards[p_hash & STRING_TABLE_SHARD_MASK]; }
+	static uint32_t _begin_lookup(_Shard &p_shard);
+	static void _free_graveyard(_Shard &p_shard);
+	template <typename T>
+	static _Data *_find(const T &p_name, uint32_t p_hash);
+	template <typename T>
+	static _Data *_intern(const T &p_name, uint32_t p_hash, const char *p_cname, bool p_static);
+
 	StringName(_Data *p_data) { _data = p_data; }
 
 public:
@@ -31,6 +31,7 @@
 #include "dictionary.h"
 
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/container_type_validate.h"
 #include "core/variant/variant.h"
@@ -40,10 +41,358 @@
 #include "core/variant/type_info.h"
 #include "core/variant/variant_internal.h"
 
+// Entries of a dictionary, in insertion order. They are stored densely in chunks
+// which never move once allocated, so like with HashMap, pointers to keys and values
+// stay valid when adding entries. Up to SMALL_SIZE entries fit the first chunk and
+// are found with a linear search, larger maps add an open addressing index table.
+//
+// Erased entries are left in place and skipped, so erasing never moves the other
+// entries. They are reclaimed when adding an entry would need a new chunk while more
+// than half of the entries are erased. Like a rehash, this moves the remaining ones.
+class DictionaryMap {
+public:
+	struct Entry {
+		Variant key;
+		Variant value;
+		uint32_t hash = 0;
+		bool erased = false;
+	};
+
+private:
+	static constexpr uint32_t SMALL_SIZE = 8;
+	static constexpr uint32_t EMPTY_INDEX = UINT32_MAX;
+
+	struct IndexSlot {
+		uint32_t hash;
+		uint32_t index;
+	};
+
+	LocalVector<Entry *> chunks; // Chunk 0 holds SMALL_SIZE entries, chunk `k > 0` holds `SMALL_SIZE << (k - 1)`.
+	uint32_t used = 0; // Constructed entries, including erased ones.
+	uint32_t count = 0;
+
+	IndexSlot *index_slots = nullptr; // Only when there are more than SMALL_SIZE entries.
+	uint32_t index_capacity = 0;
+
+	_FORCE_INLINE_ static uint32_t _get_chunk(uint32_t p_index) {
+		if (p_index < SMALL_SIZE) {
+			return 0;
+		}
+#if defined(__GNUC__)
+		return 32 - __builtin_clz(p_index / SMALL_SIZE);
+#else
+		return nearest_shift(p_index / SMALL_SIZE);
+#endif
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_chunk_start(uint32_t p_chunk) {
+		return p_chunk == 0 ? 0 : SMALL_SIZE << (p_chunk - 1);
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_chunk_size(uint32_t p_chunk) {
+		return p_chunk == 0 ? SMALL_SIZE : SMALL_SIZE << (p_chunk - 1);
+	}
+
+	_FORCE_INLINE_ Entry &_get_entry(uint32_t p_index) const {
+		const uint32_t chunk = _get_chunk(p_index);
+		return chunks[chunk][p_index - _get_chunk_start(chunk)];
+	}
+
+	void _index_insert(uint32_t p_hash, uint32_t p_index) {
+		const uint32_t mask = index_capacity - 1;
+		uint32_t pos = p_hash & mask;
+		while (index_slots[pos].index != EMPTY_INDEX) {
+			pos = (pos + 1) & mask;
+		}
+		index_slots[pos].hash = p_hash;
+		index_slots[pos].index = p_index;
+	}
+
+	void _rebuild_index() {
+		if (index_slots) {
+			Memory::free_static(index_slots);
+			index_slots = nullptr;
+			index_capacity = 0;
+		}
+		if (used <= SMALL_SIZE) {
+			return;
+		}
+
+		// Keep the load factor under one half, erased entries included.
+		index_capacity = next_power_of_2(used * 2 + 1);
+		index_slots = static_cast<IndexSlot *>(Memory::alloc_static(sizeof(IndexSlot) * index_capacity));
+		for (uint32_t i = 0; i < index_capacity; i++) {
+			index_slots[i].index = EMPTY_INDEX;
+		}
+		for (uint32_t i = 0; i < used; i++) {
+			const Entry &entry = _get_entry(i);
+			if (!entry.erased) {
+				_index_insert(entry.hash, i);
+			}
+		}
+	}
+
+	int64_t _find_index(const Variant &p_key, uint32_t p_hash) const {
+		if (!index_slots) {
+			for (uint32_t i = 0; i < used; i++) {
+				const Entry &entry = chunks[0][i];
+				if (entry.hash == p_hash && !entry.erased && StringLikeVariantComparator::compare(entry.key, p_key)) {
+					return i;
+				}
+			}
+			return -1;
+		}
+
+		const uint32_t mask = index_capacity - 1;
+		uint32_t pos = p_hash & mask;
+		while (index_slots[pos].index != EMPTY_INDEX) {
+			if (index_slots[pos].hash == p_hash) {
+				const Entry &entry = _get_entry(index_slots[pos].index);
+				if (!entry.erased && StringLikeVariantComparator::compare(entry.key, p_key)) {
+					return index_slots[pos].index;
+				}
+			}
+			pos = (pos + 1) & mask;
+		}
+		return -1;
+	}
+
+	Entry &_push_entry(const Variant &p_key, uint32_t p_hash) {
+		if (used - count > count && _get_chunk(used) == chunks.size()) {
+			// Reclaim erased entries rather than growing.
+			_compact();
+		}
+
+		const uint32_t index = used;
+		const uint32_t chunk = _get_chunk(index);
+		if (chunk == chunks.size()) {
+			chunks.push_back(static_cast<Entry *>(Memory::alloc_static(sizeof(Entry) * _get_chunk_size(chunk))));
+		}
+
+		Entry &entry = chunks[chunk][index - _get_chunk_start(chunk)];
+		memnew_placement(&entry, Entry);
+		entry.key = p_key;
+		entry.hash = p_hash;
+		used++;
+		count++;
+
+		if (used > SMALL_SIZE) {
+			if (used * 2 >= index_capacity) {
+				_rebuild_index();
+			} else {
+				_index_insert(p_hash, index);
+			}
+		}
+		return entry;
+	}
+
+	void _destroy_entries(uint32_t p_from) {
+		for (uint32_t i = p_from; i < used; i++) {
+			_get_entry(i).~Entry();
+		}
+		used = p_from;
+	}
+
+	void _compact() {
+		uint32_t live = 0;
+		for (uint32_t i = 0; i < used; i++) {
+			Entry &entry = _get_entry(i);
+			if (entry.erased) {
+				continue;
+			}
+			if (live != i) {
+				Entry &target = _get_entry(live);
+				target.key = std::move(entry.key);
+				target.value = std::move(entry.value);
+				target.hash = entry.hash;
+				target.erased = false;
+			}
+			live++;
+		}
+		_destroy_entries(live);
+		_rebuild_index();
+	}
+
+public:
+	template <bool IsConst>
+	class IteratorBase {
+		friend class DictionaryMap;
+		template <bool>
+		friend class IteratorBase;
+		using MapType = std::conditional_t<IsConst, const DictionaryMap, DictionaryMap>;
+		using EntryType = std::conditional_t<IsConst, const Entry, Entry>;
+
+		MapType *map = nullptr;
+		uint32_t index = 0;
+
+		void _skip_erased() {
+			while (index < map->used && map->_get_entry(index).erased) {
+				index++;
+			}
+		}
+
+		IteratorBase(MapType *p_map, uint32_t p_index) :
+				map(p_map), index(p_index) {
+			_skip_erased();
+		}
+
+	public:
+		EntryType &operator*() const { return map->_get_entry(index); }
+		EntryType *operator->() const { return &map->_get_entry(index); }
+		IteratorBase &operator++() {
+			index++;
+			_skip_erased();
+			return *this;
+		}
+		bool operator==(const IteratorBase &p_other) const { return index == p_other.index; }
+		bool operator!=(const IteratorBase &p_other) const { return index != p_other.index; }
+		explicit operator bool() const { return map && index < map->used; }
+
+		IteratorBase() {}
+
+		// Allows converting an iterator to a const one.
+		template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+		IteratorBase(const IteratorBase<OtherConst> &p_other) :
+				map(p_other.map), index(p_other.index) {}
+	};
+
+	using Iterator = IteratorBase<false>;
+	using ConstIterator = IteratorBase<true>;
+
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+
+	Iterator begin() { return Iterator(this, 0); }
+	Iterator end() { return Iterator(this, used); }
+	ConstIterator begin() const { return ConstIterator(this, 0); }
+	ConstIterator end() const { return ConstIterator(this, used); }
+
+	Iterator find(const Variant &p_key) {
+		const int64_t index = _find_index(p_key, VariantHasher::hash(p_key));
+		return index < 0 ? end() : Iterator(this, index);
+	}
+
+	ConstIterator find(const Variant &p_key) const {
+		const int64_t index = _find_index(p_key, VariantHasher::hash(p_key));
+		return index < 0 ? end() : ConstIterator(this, index);
+	}
+
+	bool has(const Variant &p_key) const {
+		return _find_index(p_key, VariantHasher::hash(p_key)) >= 0;
+	}
+
+	// Entry at the given position in insertion order.
+	const Entry *get_by_position(uint32_t p_position) const {
+		if (p_position >= count) {
+			return nullptr;
+		}
+		if (used == count) {
+			return &_get_entry(p_position);
+		}
+		for (const Entry &entry : *this) {
+			if (p_position == 0) {
+				return &entry;
+			}
+			p_position--;
+		}
+		return nullptr;
+	}
+
+	// Returns the entry of the key, adding it with a null value if it's missing.
+	Entry &get_or_insert(const Variant &p_key, bool *r_inserted = nullptr) {
+		const uint32_t hash = VariantHasher::hash(p_key);
+		const int64_t index = _find_index(p_key, hash);
+		if (r_inserted) {
+			*r_inserted = index < 0;
+		}
+		return index < 0 ? _push_entry(p_key, hash) : _get_entry(index);
+	}
+
+	void insert(const Variant &p_key, const Variant &p_value) {
+		get_or_insert(p_key).value = p_value;
+	}
+
+	const Variant &operator[](const Variant &p_key) const {
+		const int64_t index = _find_index(p_key, VariantHasher::hash(p_key));
+		CRASH_COND(index < 0);
+		return _get_entry(index).value;
+	}
+
+	Variant &operator[](const Variant &p_key) {
+		return get_or_insert(p_key).value;
+	}
+
+	bool erase(const Variant &p_key) {
+		const int64_t index = _find_index(p_key, VariantHasher::hash(p_key));
+		if (index < 0) {
+			return false;
+		}
+
+		Entry &entry = _get_entry(index);
+		entry.erased = true;
+		entry.key = Variant();
+		entry.value = Variant();
+		count--;
+
+		if (count == 0) {
+			clear();
+		}
+		return true;
+	}
+
+	void clear() {
+		_destroy_entries(0);
+		count = 0;
+		for (Entry *chunk : chunks) {
+			Memory::free_static(chunk);
+		}
+		chunks.clear();
+		_rebuild_index();
+	}
+
+	void sort() {
+		if (count < 2) {
+			return;
+		}
+		if (used != count) {
+			_compact();
+		}
+
+		// Insertion sort, like HashMap, since the input is often already sorted or nearly sorted.
+		for (uint32_t i = 1; i < used; i++) {
+			uint32_t j = i;
+			if (!_hashmap_variant_less_than(_get_entry(j).key, _get_entry(j - 1).key)) {
+				continue;
+			}
+			const Entry inserting = _get_entry(i);
+			while (j > 0 && _hashmap_variant_less_than(inserting.key, _get_entry(j - 1).key)) {
+				_get_entry(j) = _get_entry(j - 1);
+				j--;
+			}
+			_get_entry(j) = inserting;
+		}
+		_rebuild_index();
+	}
+
+	void operator=(const DictionaryMap &p_other) {
+		if (this == &p_other) {
+			return;
+		}
+		clear();
+		for (const Entry &entry : p_other) {
+			_push_entry(entry.key, entry.hash).value = entry.value;
+		}
+	}
+
+	DictionaryMap() {}
+	DictionaryMap(const DictionaryMap &p_other) { operator=(p_other); }
+	~DictionaryMap() { clear(); }
+};
+
 struct DictionaryPrivate {
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
+	DictionaryMap variant_map;
 	ContainerTypeValidate typed_key;
 	ContainerTypeValidate typed_value;
 	Variant *typed_fallback = nullptr; // Allows a typed dictionary to return dummy values when attempting an invalid access.
@@ -54,33 +403,21 @@ void Dictionary::get_key_list(List<Variant> *p_keys) const {
 		return;
 	}
 
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const DictionaryMap::Entry &E : _p->variant_map) {
 		p_keys->push_back(E.key);
 	}
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.key;
-		}
-		index++;
-	}
-
-	return Variant();
+	ERR_FAIL_COND_V(p_index < 0, Variant());
+	const DictionaryMap::Entry *entry = _p->variant_map.get_by_position(p_index);
+	return entry ? entry->key : Variant();
 }
 
 Variant Dictionary::get_value_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.value;
-		}
-		index++;
-	}
-
-	return Variant();
+	ERR_FAIL_COND_V(p_index < 0, Variant());
+	const DictionaryMap::Entry *entry = _p->variant_map.get_by_position(p_index);
+	return entry ? entry->value : Variant();
 }
 
 // WARNING: This operator does not validate the value type. For scripting/extensions this is
@@ -127,7 +464,7 @@ const Variant *Dictionary::getptr(const Variant &p_key) const {
 	if (unlikely(!_p->typed_key.validate(key, "getptr"))) {
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(key));
+	DictionaryMap::ConstIterator E(_p->variant_map.find(key));
 	if (!E) {
 		return nullptr;
 	}
@@ -140,7 +477,7 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 	if (unlikely(!_p->typed_key.validate(key, "getptr"))) {
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(key));
+	DictionaryMap::Iterator E(_p->variant_map.find(key));
 	if (!E) {
 		return nullptr;
 	}
@@ -155,7 +492,7 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 Variant Dictionary::get_valid(const Variant &p_key) const {
 	Variant key = p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "get_valid"), Variant());
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(key));
+	DictionaryMap::ConstIterator E(_p->variant_map.find(key));
 
 	if (!E) {
 		return Variant();
@@ -225,7 +562,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 Variant Dictionary::find_key(const Variant &p_value) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed_value.validate(value, "find_key"), Variant());
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const DictionaryMap::Entry &E : _p->variant_map) {
 		if (E.value == value) {
 			return E.key;
 		}
@@ -263,8 +600,8 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 		return true;
 	}
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
+	for (const DictionaryMap::Entry &this_E : _p->variant_map) {
+		DictionaryMap::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
 		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
 			return false;
 		}
@@ -301,7 +638,7 @@ void Dictionary::sort() {
 
 void Dictionary::merge(const Dictionary &p_dictionary, bool p_overwrite) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+	for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 		Variant key = E.key;
 		Variant value = E.value;
 		ERR_FAIL_COND(!_p->typed_key.validate(key, "merge"));
@@ -345,7 +682,7 @@ uint32_t Dictionary::recursive_hash(int recursion_count) const {
 	uint32_t h = hash_murmur3_one_32(Variant::DICTIONARY);
 
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const DictionaryMap::Entry &E : _p->variant_map) {
 		h = hash_murmur3_one_32(E.key.recursive_hash(recursion_count), h);
 		h = hash_murmur3_one_32(E.value.recursive_hash(recursion_count), h);
 	}
@@ -365,7 +702,7 @@ Array Dictionary::keys() const {
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const DictionaryMap::Entry &E : _p->variant_map) {
 		varr[i] = E.key;
 		i++;
 	}
@@ -385,7 +722,7 @@ Array Dictionary::values() const {
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const DictionaryMap::Entry &E : _p->variant_map) {
 		varr[i] = E.value;
 		i++;
 	}
@@ -410,7 +747,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	}
 
 	int size = p_dictionary._p->variant_map.size();
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map = HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>(size);
+	DictionaryMap variant_map;
 
 	Vector<Variant> key_array;
 	key_array.resize(size);
@@ -425,7 +762,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// from anything to variants or,
 		// from subclasses to base classes.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *key = &E.key;
 			key_data[i++] = *key;
 		}
@@ -433,7 +770,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// From variants to objects or,
 		// from base classes to subclasses.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *key = &E.key;
 			if (key->get_type() != Variant::NIL && (key->get_type() != Variant::OBJECT || !typed_key.validate_object(*key, "assign"))) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert key from "%s" to "%s".)", Variant::get_type_name(key->get_type()), Variant::get_type_name(typed_key.type)));
@@ -446,7 +783,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (typed_key_source.type == Variant::NIL && typed_key.type != Variant::OBJECT) {
 		// From variants to primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *key = &E.key;
 			if (key->get_type() == typed_key.type) {
 				key_data[i++] = *key;
@@ -462,7 +799,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (Variant::can_convert_strict(typed_key_source.type, typed_key.type)) {
 		// From primitives to different convertible primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *key = &E.key;
 			Callable::CallError ce;
 			Variant::construct(typed_key.type, key_data[i++], &key, 1, ce);
@@ -478,7 +815,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// from anything to variants or,
 		// from subclasses to base classes.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *value = &E.value;
 			value_data[i++] = *value;
 		}
@@ -486,7 +823,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// From variants to objects or,
 		// from base classes to subclasses.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *value = &E.value;
 			if (value->get_type() != Variant::NIL && (value->get_type() != Variant::OBJECT || !typed_value.validate_object(*value, "assign"))) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert value at key "%s" from "%s" to "%s".)", key_data[i], Variant::get_type_name(value->get_type()), Variant::get_type_name(typed_value.type)));
@@ -499,7 +836,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (typed_value_source.type == Variant::NIL && typed_value.type != Variant::OBJECT) {
 		// From variants to primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *value = &E.value;
 			if (value->get_type() == typed_value.type) {
 				value_data[i++] = *value;
@@ -515,7 +852,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (Variant::can_convert_strict(typed_value_source.type, typed_value.type)) {
 		// From primitives to different convertible primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const DictionaryMap::Entry &E : p_dictionary._p->variant_map) {
 			const Variant *value = &E.value;
 			Callable::CallError ce;
 			Variant::construct(typed_value.type, value_data[i++], &value, 1, ce);
@@ -543,7 +880,7 @@ const Variant *Dictionary::next(const Variant *p_key) const {
 	}
 	Variant key = *p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "next"), nullptr);
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(key);
+	DictionaryMap::Iterator E = _p->variant_map.find(key);
 
 	if (!E) {
 		return nullptr;
@@ -583,11 +920,11 @@ Dictionary Dictionary::recursive_duplicate(bool p_deep, int recursion_count) con
 
 	if (p_deep) {
 		recursion_count++;
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+		for (const DictionaryMap::Entry &E : _p->variant_map) {
 			n[E.key.recursive_duplicate(true, recursion_count)] = E.value.recursive_duplicate(true, recursion_count);
 		}
 	} else {
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+		for (const DictionaryMap::Entry &E : _p->variant_map) {
 			n[E.key] = E.value;
 		}
 	}
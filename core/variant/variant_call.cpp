@@ -662,6 +662,22 @@ static _FORCE_INLINE_ void vc_ptrcall(void (*method)(T *, P...), void *p_base, c
 		return p_instance->get(p_index);                                                          \
 	}
 
+// Scalar type used when scaling the elements of a packed array in place.
+template <typename T>
+struct _PackedArrayScalar {
+	typedef real_t Type;
+};
+
+template <>
+struct _PackedArrayScalar<float> {
+	typedef float Type;
+};
+
+template <>
+struct _PackedArrayScalar<double> {
+	typedef double Type;
+};
+
 struct _VariantCall {
 	VARCALL_PACKED_GETTER(PackedByteArray, uint8_t)
 	VARCALL_PACKED_GETTER(PackedColorArray, Color)
@@ -1034,6 +1050,182 @@ struct _VariantCall {
 		return len;
 	}
 
+	// Element-wise bulk math for packed arrays. The loops run directly over the
+	// raw buffers so the compiler can auto-vectorize them, instead of going
+	// through the VM and Variant operators once per element.
+
+	template <typename T>
+	static void func_Packed_add_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_array.size() != size, vformat("Array sizes must match (%d != %d).", size, p_array.size()));
+		const T *src = p_array.ptr();
+		T *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] += src[i];
+		}
+	}
+
+	template <typename T>
+	static void func_Packed_multiply_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_array.size() != size, vformat("Array sizes must match (%d != %d).", size, p_array.size()));
+		const T *src = p_array.ptr();
+		T *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] *= src[i];
+		}
+	}
+
+	template <typename T>
+	static void func_Packed_multiply_add_array(Vector<T> *p_instance, const Vector<T> &p_array, double p_weight) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_array.size() != size, vformat("Array sizes must match (%d != %d).", size, p_array.size()));
+		const typename _PackedArrayScalar<T>::Type weight = p_weight;
+		const T *src = p_array.ptr();
+		T *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] += src[i] * weight;
+		}
+	}
+
+	template <typename T>
+	static void func_Packed_add_scalar(Vector<T> *p_instance, double p_value) {
+		const int64_t size = p_instance->size();
+		const T value = p_value;
+		T *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] += value;
+		}
+	}
+
+	template <typename T>
+	static void func_Packed_multiply_scalar(Vector<T> *p_instance, double p_value) {
+		const int64_t size = p_instance->size();
+		const typename _PackedArrayScalar<T>::Type value = p_value;
+		T *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] *= value;
+		}
+	}
+
+	template <typename T>
+	static void func_Packed_clamp_scalar(Vector<T> *p_instance, double p_min, double p_max) {
+		ERR_FAIL_COND_MSG(p_min > p_max, vformat("Minimum %f can't be greater than maximum %f.", p_min, p_max));
+		const int64_t size = p_instance->size();
+		const T min = p_min;
+		const T max = p_max;
+		T *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] = CLAMP(dst[i], min, max);
+		}
+	}
+
+	template <typename T>
+	static void func_Packed_clamp_vector(Vector<T> *p_instance, const T &p_min, const T &p_max) {
+		ERR_FAIL_COND_MSG(p_max.max(p_min) != p_max, vformat("Minimum %s can't be greater than maximum %s in any component.", p_min, p_max));
+		const int64_t size = p_instance->size();
+		T *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] = dst[i].clamp(p_min, p_max);
+		}
+	}
+
+	static void func_PackedVector2Array_transform(PackedVector2Array *p_instance, const Transform2D &p_transform) {
+		const int64_t size = p_instance->size();
+		Vector2 *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] = p_transform.xform(dst[i]);
+		}
+	}
+
+	static void func_PackedVector3Array_transform(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		const int64_t size = p_instance->size();
+		Vector3 *dst = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] = p_transform.xform(dst[i]);
+		}
+	}
+
+	// Reductions accumulate in double and keep four independent partial sums,
+	// which breaks the loop-carried dependency without reordering the result
+	// between platforms.
+	template <typename T>
+	static double func_Packed_sum_scalar(Vector<T> *p_instance) {
+		const int64_t size = p_instance->size();
+		const T *src = p_instance->ptr();
+		double acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+		int64_t i = 0;
+		for (; i + 4 <= size; i += 4) {
+			acc[0] += src[i + 0];
+			acc[1] += src[i + 1];
+			acc[2] += src[i + 2];
+			acc[3] += src[i + 3];
+		}
+		for (; i < size; i++) {
+			acc[0] += src[i];
+		}
+		return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+	}
+
+	template <typename T>
+	static double func_Packed_dot(Vector<T> *p_instance, const Vector<T> &p_array) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(p_array.size() != size, 0.0, vformat("Array sizes must match (%d != %d).", size, p_array.size()));
+		const T *a = p_instance->ptr();
+		const T *b = p_array.ptr();
+		double acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+		int64_t i = 0;
+		for (; i + 4 <= size; i += 4) {
+			acc[0] += double(a[i + 0]) * b[i + 0];
+			acc[1] += double(a[i + 1]) * b[i + 1];
+			acc[2] += double(a[i + 2]) * b[i + 2];
+			acc[3] += double(a[i + 3]) * b[i + 3];
+		}
+		for (; i < size; i++) {
+			acc[0] += double(a[i]) * b[i];
+		}
+		return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+	}
+
+	template <typename T>
+	static Variant func_Packed_min(Vector<T> *p_instance) {
+		const int64_t size = p_instance->size();
+		if (size == 0) {
+			return Variant();
+		}
+		const T *src = p_instance->ptr();
+		T result = src[0];
+		for (int64_t i = 1; i < size; i++) {
+			result = MIN(result, src[i]);
+		}
+		return result;
+	}
+
+	template <typename T>
+	static Variant func_Packed_max(Vector<T> *p_instance) {
+		const int64_t size = p_instance->size();
+		if (size == 0) {
+			return Variant();
+		}
+		const T *src = p_instance->ptr();
+		T result = src[0];
+		for (int64_t i = 1; i < size; i++) {
+			result = MAX(result, src[i]);
+		}
+		return result;
+	}
+
+	template <typename T>
+	static T func_Packed_sum_vector(Vector<T> *p_instance) {
+		const int64_t size = p_instance->size();
+		const T *src = p_instance->ptr();
+		T acc;
+		for (int64_t i = 0; i < size; i++) {
+			acc += src[i];
+		}
+		return acc;
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2535,6 +2727,16 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, add_array, _VariantCall::func_Packed_add_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_array, _VariantCall::func_Packed_multiply_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_add_array, _VariantCall::func_Packed_multiply_add_array<float>, sarray("array", "weight"), varray());
+	bind_functionnc(PackedFloat32Array, add_scalar, _VariantCall::func_Packed_add_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, clamp, _VariantCall::func_Packed_clamp_scalar<float>, sarray("min", "max"), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_Packed_dot<float>, sarray("array"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_Packed_sum_scalar<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_Packed_min<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_Packed_max<float>, sarray(), varray());
 
 	/* Float64 Array */
 
@@ -2559,6 +2761,16 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat64Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat64Array, count, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, add_array, _VariantCall::func_Packed_add_array<double>, sarray("array"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_array, _VariantCall::func_Packed_multiply_array<double>, sarray("array"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_add_array, _VariantCall::func_Packed_multiply_add_array<double>, sarray("array", "weight"), varray());
+	bind_functionnc(PackedFloat64Array, add_scalar, _VariantCall::func_Packed_add_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, clamp, _VariantCall::func_Packed_clamp_scalar<double>, sarray("min", "max"), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_Packed_dot<double>, sarray("array"), varray());
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_Packed_sum_scalar<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, min, _VariantCall::func_Packed_min<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, max, _VariantCall::func_Packed_max<double>, sarray(), varray());
 
 	/* String Array */
 
@@ -2607,6 +2819,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector2Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector2Array, add_array, _VariantCall::func_Packed_add_array<Vector2>, sarray("array"), varray());
+	bind_functionnc(PackedVector2Array, multiply_array, _VariantCall::func_Packed_multiply_array<Vector2>, sarray("array"), varray());
+	bind_functionnc(PackedVector2Array, multiply_add_array, _VariantCall::func_Packed_multiply_add_array<Vector2>, sarray("array", "weight"), varray());
+	bind_functionnc(PackedVector2Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<Vector2>, sarray("value"), varray());
+	bind_functionnc(PackedVector2Array, clamp, _VariantCall::func_Packed_clamp_vector<Vector2>, sarray("min", "max"), varray());
+	bind_functionnc(PackedVector2Array, transform, _VariantCall::func_PackedVector2Array_transform, sarray("transform"), varray());
+	bind_function(PackedVector2Array, sum, _VariantCall::func_Packed_sum_vector<Vector2>, sarray(), varray());
 
 	/* Vector3 Array */
 
@@ -2631,6 +2850,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, add_array, _VariantCall::func_Packed_add_array<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, multiply_array, _VariantCall::func_Packed_multiply_array<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, multiply_add_array, _VariantCall::func_Packed_multiply_add_array<Vector3>, sarray("array", "weight"), varray());
+	bind_functionnc(PackedVector3Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<Vector3>, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, clamp, _VariantCall::func_Packed_clamp_vector<Vector3>, sarray("min", "max"), varray());
+	bind_functionnc(PackedVector3Array, transform, _VariantCall::func_PackedVector3Array_transform, sarray("transform"), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_Packed_sum_vector<Vector3>, sarray(), varray());
 
 	/* Color Array */
 
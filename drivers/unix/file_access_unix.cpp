@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -171,6 +172,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped_data) {
+		munmap(mapped_data, mapped_length);
+		mapped_data = nullptr;
+		mapped_length = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -276,6 +283,39 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::map_read_only(uint64_t &r_length) {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+#ifdef WEB_ENABLED
+	// The web filesystem is memory-backed already, mapping would only add a copy.
+	return nullptr;
+#else
+	if (!mapped_data) {
+		if (flags != READ) {
+			return nullptr;
+		}
+
+		struct stat st = {};
+		if (fstat(fileno(f), &st) != 0 || st.st_size <= 0 || (uint64_t)st.st_size > SIZE_MAX) {
+			return nullptr; // Empty, or too large for the address space (e.g. 32-bit).
+		}
+
+		// Shared read-only mapping, so every process mapping the same file reuses
+		// the same page cache pages instead of keeping private copies.
+		void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fileno(f), 0);
+		if (data == MAP_FAILED) {
+			return nullptr;
+		}
+
+		mapped_data = (uint8_t *)data;
+		mapped_length = st.st_size;
+	}
+
+	r_length = mapped_length;
+	return mapped_data;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	uint8_t *mapped_data = nullptr;
+	uint64_t mapped_length = 0;
+
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -72,6 +75,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_read_only(uint64_t &r_length) override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -30,6 +30,7 @@
 
 #include "performance.h"
 
+#include "core/os/frame_allocator.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
@@ -97,6 +98,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_SURFACE);
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_DRAW);
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_SPECIALIZATION);
+	BIND_ENUM_CONSTANT(NAVIGATION_SYNC_POLYGON_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_ALLOCATIONS_PER_FRAME);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_ALLOCATIONS_PER_FRAME);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_SIZE);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -151,6 +156,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("pipeline/compilations_surface"),
 		PNAME("pipeline/compilations_draw"),
 		PNAME("pipeline/compilations_specialization"),
+		PNAME("navigation/sync_polygons"),
+		PNAME("memory/allocations_per_frame"),
+		PNAME("memory/frame_arena_allocations_per_frame"),
+		PNAME("memory/frame_arena_size"),
 	};
 
 	return names[p_monitor];
@@ -246,6 +255,14 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
 		case NAVIGATION_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
+		case NAVIGATION_SYNC_POLYGON_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_SYNC_POLYGON_COUNT);
+		case MEMORY_ALLOCATIONS_PER_FRAME:
+			return FrameAllocator::get_malloc_calls_per_frame();
+		case MEMORY_FRAME_ARENA_ALLOCATIONS_PER_FRAME:
+			return FrameAllocator::get_arena_allocations_per_frame();
+		case MEMORY_FRAME_ARENA_SIZE:
+			return FrameAllocator::get_reserved_memory();
 
 		default: {
 		}
@@ -292,6 +309,15 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
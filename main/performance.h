@@ -106,6 +106,10 @@ public:
 		PIPELINE_COMPILATIONS_SURFACE,
 		PIPELINE_COMPILATIONS_DRAW,
 		PIPELINE_COMPILATIONS_SPECIALIZATION,
+		NAVIGATION_SYNC_POLYGON_COUNT,
+		MEMORY_ALLOCATIONS_PER_FRAME,
+		MEMORY_FRAME_ARENA_ALLOCATIONS_PER_FRAME,
+		MEMORY_FRAME_ARENA_SIZE,
 		MONITOR_MAX
 	};
 
@@ -2814,6 +2814,18 @@ void GDScriptAnalyzer::reduce_assignment(GDScriptParser::AssignmentNode *p_assig
 
 	reduce_expression(p_assignment->assignee);
 
+	// The compiler may replace locals that are never modified by their initial value.
+	const GDScriptParser::ExpressionNode *assignee_root = p_assignment->assignee;
+	while (assignee_root->type == GDScriptParser::Node::SUBSCRIPT) {
+		assignee_root = static_cast<const GDScriptParser::SubscriptNode *>(assignee_root)->base;
+	}
+	if (assignee_root->type == GDScriptParser::Node::IDENTIFIER) {
+		const GDScriptParser::IdentifierNode *id = static_cast<const GDScriptParser::IdentifierNode *>(assignee_root);
+		if (id->source == GDScriptParser::IdentifierNode::LOCAL_VARIABLE && id->variable_source) {
+			id->variable_source->modified = true;
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	{
 		bool is_subscript = false;
@@ -395,9 +395,18 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
+	function->line_mappings = line_mappings;
 	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
 
@@ -615,6 +624,10 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		last_operator_pos = opcodes.size();
+		last_operator_target = p_target;
+		last_operator_result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -693,17 +706,11 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 }
 
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
-	logic_op_jump_pos1.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos1.push_back(write_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_left_operand));
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
-	logic_op_jump_pos2.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos2.push_back(write_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_right_operand));
 }
 
 void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
@@ -723,17 +730,11 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_left_operand);
-	logic_op_jump_pos1.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos1.push_back(write_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF, p_left_operand));
 }
 
 void GDScriptByteCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_right_operand);
-	logic_op_jump_pos2.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos2.push_back(write_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF, p_right_operand));
 }
 
 void GDScriptByteCodeGenerator::write_end_or(const Address &p_target) {
@@ -757,10 +758,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	ternary_jump_fail_pos.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	ternary_jump_fail_pos.push_back(write_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
@@ -861,6 +859,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -879,6 +878,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -994,6 +994,11 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_target);
 		append(p_source);
 		append(p_target.type.builtin_type);
+	} else if (can_fuse_with_operator(p_source)) {
+		// Result of a validated operator stored right away: evaluate and store in one dispatch.
+		opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+		last_operator_pos = -1;
+		append(p_target);
 	} else {
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
@@ -1023,6 +1028,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	last_operator_pos = -1;
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1093,6 +1099,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1118,6 +1125,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1352,6 +1360,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1365,6 +1374,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1378,6 +1388,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1511,11 +1522,23 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 	append(p_target);
 }
 
-void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	if_jmp_addrs.push_back(opcodes.size());
+int GDScriptByteCodeGenerator::write_conditional_jump(GDScriptFunction::Opcode p_jump, GDScriptFunction::Opcode p_fused_jump, const Address &p_condition) {
+	if (last_operator_result_type == Variant::BOOL && can_fuse_with_operator(p_condition)) {
+		// Comparison followed by a branch on its result: test the boolean in the same instruction.
+		// The operator target is kept so the temporary still holds the result.
+		opcodes.write[last_operator_pos] = p_fused_jump;
+		last_operator_pos = -1;
+	} else {
+		append_opcode(p_jump);
+		append(p_condition);
+	}
+	int jump_pos = opcodes.size();
 	append(0); // Jump destination, will be patched.
+	return jump_pos;
+}
+
+void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	if_jmp_addrs.push_back(write_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_else() {
@@ -1719,14 +1742,12 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator_pos = -1;
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	while_jmp_addrs.push_back(opcodes.size());
-	append(0); // End of loop address, will be patched.
+	while_jmp_addrs.push_back(write_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_endwhile() {
@@ -1761,7 +1782,27 @@ void GDScriptByteCodeGenerator::write_breakpoint() {
 	append_opcode(GDScriptFunction::OPCODE_BREAKPOINT);
 }
 
+void GDScriptByteCodeGenerator::set_line(int p_line) {
+	GDScriptFunction::LineMapping mapping;
+	mapping.ip = opcodes.size();
+	mapping.line = p_line;
+
+	if (!line_mappings.is_empty()) {
+		const GDScriptFunction::LineMapping &last = line_mappings[line_mappings.size() - 1];
+		if (last.line == p_line) {
+			return;
+		}
+		if (last.ip == mapping.ip) {
+			// No code was written for the previous line.
+			line_mappings.write[line_mappings.size() - 1] = mapping;
+			return;
+		}
+	}
+	line_mappings.push_back(mapping);
+}
+
 void GDScriptByteCodeGenerator::write_newline(int p_line) {
+	set_line(p_line);
 	append_opcode(GDScriptFunction::OPCODE_LINE);
 	append(p_line);
 	current_line = p_line;
@@ -92,12 +92,20 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<Variant::Type, List<int>> temporaries_pool;
 
 	List<GDScriptFunction::StackDebug> stack_debug;
+	Vector<GDScriptFunction::LineMapping> line_mappings;
 	List<RBMap<StringName, int>> block_identifier_stack;
 	RBMap<StringName, int> block_identifiers;
 
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
+
+	// Position of the last emitted validated operator, so a jump or assignment
+	// consuming its result right away can be fused into a single instruction.
+	int last_operator_pos = -1;
+	Address last_operator_target;
+	Variant::Type last_operator_result_type = Variant::NIL;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -447,10 +455,22 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		// Something jumps here, so the previous instruction can't be fused with the next.
+		last_operator_pos = -1;
 	}
 
+	bool can_fuse_with_operator(const Address &p_operand) const {
+		return last_operator_pos >= 0 && last_operator_pos + 5 == opcodes.size() && p_operand.mode == Address::TEMPORARY && last_operator_target.mode == Address::TEMPORARY && p_operand.address == last_operator_target.address;
+	}
+
+	int write_conditional_jump(GDScriptFunction::Opcode p_jump, GDScriptFunction::Opcode p_fused_jump, const Address &p_condition);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -476,6 +496,7 @@ public:
 	virtual void set_signature(const String &p_signature) override;
 #endif
 	virtual void set_initial_line(int p_line) override;
+	virtual void set_line(int p_line) override;
 
 	virtual void write_type_adjust(const Address &p_target, Variant::Type p_new_type) override;
 	virtual void write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) override;
@@ -0,0 +1,2065 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_compiler.h"
+#include "gdscript_function.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+#define BYTECODE_CACHE_MAGIC "GDBC"
+
+enum ConstantTag {
+	CONSTANT_VALUE,
+	CONSTANT_NULL_OBJECT,
+	CONSTANT_GLOBAL,
+	CONSTANT_SCRIPT,
+	CONSTANT_RESOURCE,
+	CONSTANT_ARRAY,
+	CONSTANT_DICTIONARY,
+};
+
+// Reverse lookup of the validated functions compiled code points to, so they can be stored by name.
+struct GDScriptFunctionSymbols {
+	struct Operator {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type left = Variant::NIL;
+		Variant::Type right = Variant::NIL;
+	};
+
+	struct Member {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct Constructor {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, Operator> operators;
+	RBMap<Variant::ValidatedSetter, Member> setters;
+	RBMap<Variant::ValidatedGetter, Member> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Member> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Constructor> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	GDScriptFunctionSymbols() {
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			const Variant::Type type = Variant::Type(i);
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, { Variant::Operator(op), type, Variant::Type(j) });
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+				if (setter && !setters.has(setter)) {
+					setters.insert(setter, { type, member });
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+				if (getter && !getters.has(getter)) {
+					getters.insert(getter, { type, member });
+				}
+			}
+
+			Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+			if (keyed_setter && !keyed_setters.has(keyed_setter)) {
+				keyed_setters.insert(keyed_setter, type);
+			}
+			Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+			if (keyed_getter && !keyed_getters.has(keyed_getter)) {
+				keyed_getters.insert(keyed_getter, type);
+			}
+			Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+			if (indexed_setter && !indexed_setters.has(indexed_setter)) {
+				indexed_setters.insert(indexed_setter, type);
+			}
+			Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+			if (indexed_getter && !indexed_getters.has(indexed_getter)) {
+				indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+				if (builtin_method && !builtin_methods.has(builtin_method)) {
+					builtin_methods.insert(builtin_method, { type, method });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor && !constructors.has(constructor)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(function);
+			if (utility && !utilities.has(utility)) {
+				utilities.insert(utility, function);
+			}
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			GDScriptUtilityFunctions::FunctionPtr gds_utility = GDScriptUtilityFunctions::get_function(function);
+			if (gds_utility && !gds_utilities.has(gds_utility)) {
+				gds_utilities.insert(gds_utility, function);
+			}
+		}
+	}
+};
+
+static GDScriptFunctionSymbols *function_symbols = nullptr;
+
+template <typename K, typename V>
+static const V *_find_symbol(const RBMap<K, V> &p_map, const K &p_key) {
+	const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+	return E ? &E->value() : nullptr;
+}
+
+// Checks the operands of loaded code against the tables of its function. Release builds
+// run bytecode without bounds checks, and cache entries are stored in a writable location.
+struct GDScriptBytecodeCache::CodeValidator {
+	int *code = nullptr;
+	int code_size = 0;
+	int ip = 0;
+	bool valid = true;
+
+	const GDScriptFunction *function = nullptr;
+	int address_limits[GDScriptFunction::ADDR_TYPE_MAX] = {};
+	LocalVector<int> jump_targets;
+
+	// Word `p_offset` of the current instruction.
+	int word(int p_offset) {
+		if (ip + p_offset >= code_size) {
+			valid = false;
+			return 0;
+		}
+		return code[ip + p_offset];
+	}
+
+	void index(int p_offset, int p_limit) {
+		const int value = word(p_offset);
+		if (value < 0 || value >= p_limit) {
+			valid = false;
+		}
+	}
+
+	void type(int p_offset) {
+		index(p_offset, Variant::VARIANT_MAX);
+	}
+
+	void name(int p_offset) {
+		index(p_offset, function->_global_names_count);
+	}
+
+	void jump(int p_offset) {
+		jump_targets.push_back(word(p_offset));
+	}
+
+	void address(int p_offset) {
+		const int address = word(p_offset);
+		const int address_type = (address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		if (address_type < 0 || address_type >= GDScriptFunction::ADDR_TYPE_MAX || (address & GDScriptFunction::ADDR_MASK) >= address_limits[address_type]) {
+			valid = false;
+		}
+	}
+
+	void addresses(int p_offset, int p_count) {
+		for (int i = 0; i < p_count && valid; i++) {
+			address(p_offset + i);
+		}
+	}
+
+	// Layout of `LOAD_INSTRUCTION_ARGS`: a count followed by that many addresses. Returns the count,
+	// the operands of the instruction itself start at `count + 2`.
+	int instruction_args(int p_needed_extra, int p_per_arg, int p_arg_offset) {
+		const int count = word(1);
+		if (count < 0 || count > function->_instruction_args_size) {
+			valid = false;
+			return 0;
+		}
+		addresses(2, count);
+		const int argc = word(count + 2 + p_arg_offset);
+		if (argc < 0 || count < argc * p_per_arg + p_needed_extra) {
+			valid = false;
+		}
+		return count;
+	}
+
+	// Returns the size of the instruction at `ip`, or 0 when it isn't valid.
+	int check_instruction() {
+		switch (code[ip]) {
+			case GDScriptFunction::OPCODE_OPERATOR: {
+				constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+				if (ip + 7 + pointer_size > code_size) {
+					return 0;
+				}
+				addresses(1, 3);
+				index(4, Variant::OP_MAX);
+				// Signature, return type and evaluator are filled on first run, never trust stored ones.
+				for (int i = 5; i < 7 + pointer_size; i++) {
+					code[ip + i] = 0;
+				}
+				return 7 + pointer_size;
+			}
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				addresses(1, 3);
+				index(4, function->_operator_funcs_count);
+				return 5;
+			}
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				addresses(1, 3);
+				index(4, function->_operator_funcs_count);
+				jump(5);
+				return 6;
+			}
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				addresses(1, 3);
+				index(4, function->_operator_funcs_count);
+				address(5);
+				return 6;
+			}
+			case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+			case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+				addresses(1, 2);
+				type(3);
+				return 4;
+			}
+			case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+				addresses(1, 3);
+				type(4);
+				name(5);
+				return 6;
+			}
+			case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY:
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+				addresses(1, 4);
+				type(5);
+				name(6);
+				type(7);
+				name(8);
+				return 9;
+			}
+			case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE: {
+				addresses(1, 2);
+				name(3);
+				return 4;
+			}
+			case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+			case GDScriptFunction::OPCODE_SET_KEYED:
+			case GDScriptFunction::OPCODE_GET_KEYED:
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+			case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+			case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+				addresses(1, 3);
+				return 4;
+			}
+			case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+				addresses(1, 3);
+				index(4, function->_keyed_setters_count);
+				return 5;
+			}
+			case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+				addresses(1, 3);
+				index(4, function->_keyed_getters_count);
+				return 5;
+			}
+			case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+				addresses(1, 3);
+				index(4, function->_indexed_setters_count);
+				return 5;
+			}
+			case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+				addresses(1, 3);
+				index(4, function->_indexed_getters_count);
+				return 5;
+			}
+			case GDScriptFunction::OPCODE_SET_NAMED:
+			case GDScriptFunction::OPCODE_GET_NAMED: {
+				addresses(1, 2);
+				name(3);
+				index(4, function->_inline_caches_count);
+				return 5;
+			}
+			case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+				addresses(1, 2);
+				index(3, function->_setters_count);
+				return 4;
+			}
+			case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+				addresses(1, 2);
+				index(3, function->_getters_count);
+				return 4;
+			}
+			case GDScriptFunction::OPCODE_SET_MEMBER:
+			case GDScriptFunction::OPCODE_GET_MEMBER: {
+				address(1);
+				name(2);
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+			case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE: {
+				address(1);
+				// The class is a script constant, or the current class in the static initializer.
+				const int class_address = word(2);
+				const GDScript *script = nullptr;
+				if (class_address == GDScriptFunction::ADDR_CLASS && function == function->_script->static_initializer) {
+					script = function->_script;
+				} else if ((class_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS == GDScriptFunction::ADDR_TYPE_CONSTANT) {
+					address(2);
+					if (valid) {
+						script = Object::cast_to<GDScript>(function->_constants_ptr[class_address & GDScriptFunction::ADDR_MASK].get_validated_object());
+					}
+				}
+				if (script == nullptr) {
+					valid = false;
+					return 0;
+				}
+				index(3, script->static_variables.size());
+				return 4;
+			}
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				addresses(1, 2);
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_ASSIGN_NULL:
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+			case GDScriptFunction::OPCODE_AWAIT_RESUME:
+			case GDScriptFunction::OPCODE_RETURN: {
+				address(1);
+				return 2;
+			}
+			case GDScriptFunction::OPCODE_AWAIT: {
+				address(1);
+				// Resuming reads the operand of the next instruction and skips it.
+				if (word(2) != GDScriptFunction::OPCODE_AWAIT_RESUME) {
+					valid = false;
+				}
+				return 2;
+			}
+			case GDScriptFunction::OPCODE_CONSTRUCT: {
+				const int count = instruction_args(1, 1, 0);
+				type(count + 3);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+				const int count = instruction_args(1, 1, 0);
+				index(count + 3, function->_constructors_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+				return instruction_args(1, 1, 0) + 3;
+			}
+			case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+				const int count = instruction_args(2, 1, 0);
+				type(count + 3);
+				name(count + 4);
+				return count + 5;
+			}
+			case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+				return instruction_args(1, 2, 0) + 3;
+			}
+			case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+				const int count = instruction_args(3, 2, 0);
+				type(count + 3);
+				name(count + 4);
+				type(count + 5);
+				name(count + 6);
+				return count + 7;
+			}
+			case GDScriptFunction::OPCODE_CALL:
+			case GDScriptFunction::OPCODE_CALL_RETURN:
+			case GDScriptFunction::OPCODE_CALL_ASYNC: {
+				const int count = instruction_args(code[ip] == GDScriptFunction::OPCODE_CALL ? 1 : 2, 1, 0);
+				name(count + 3);
+				index(count + 4, function->_inline_caches_count);
+				return count + 5;
+			}
+			case GDScriptFunction::OPCODE_CALL_UTILITY: {
+				const int count = instruction_args(1, 1, 0);
+				name(count + 3);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+				const int count = instruction_args(1, 1, 0);
+				index(count + 3, function->_utilities_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY: {
+				const int count = instruction_args(1, 1, 0);
+				index(count + 3, function->_gds_utilities_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+				const int count = instruction_args(2, 1, 0);
+				index(count + 3, function->_builtin_methods_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+				const int count = instruction_args(1, 1, 0);
+				name(count + 3);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+				const int count = instruction_args(code[ip] == GDScriptFunction::OPCODE_CALL_METHOD_BIND ? 1 : 2, 1, 0);
+				index(count + 3, function->_methods_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+				const int count = instruction_args(1, 1, 2);
+				type(count + 2);
+				name(count + 3);
+				return count + 5;
+			}
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC: {
+				const int count = instruction_args(1, 1, 1);
+				index(count + 2, function->_methods_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+				const int count = instruction_args(1, 1, 0);
+				index(count + 3, function->_methods_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+			case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA: {
+				const int count = instruction_args(1, 1, 0);
+				index(count + 3, function->_lambdas_count);
+				return count + 4;
+			}
+			case GDScriptFunction::OPCODE_JUMP: {
+				jump(1);
+				return 2;
+			}
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+				address(1);
+				jump(2);
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+			case GDScriptFunction::OPCODE_BREAKPOINT: {
+				return 1;
+			}
+			case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+				address(1);
+				type(2);
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY: {
+				addresses(1, 2);
+				type(3);
+				name(4);
+				return 5;
+			}
+			case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY: {
+				addresses(1, 3);
+				type(4);
+				name(5);
+				type(6);
+				name(7);
+				return 8;
+			}
+			case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+			case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT: {
+				addresses(1, 2);
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_STORE_GLOBAL: {
+				address(1);
+				index(2, GDScriptLanguage::get_singleton()->get_global_array_size());
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+				address(1);
+				name(2);
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_ASSERT: {
+				address(1);
+				if (word(2) != 0) {
+					address(2);
+				}
+				return 3;
+			}
+			case GDScriptFunction::OPCODE_LINE: {
+				word(1);
+				return 2;
+			}
+			default: {
+				if (code[ip] >= GDScriptFunction::OPCODE_ITERATE_BEGIN && code[ip] <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+					addresses(1, 3);
+					jump(4);
+					return 5;
+				}
+				if (code[ip] >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && code[ip] <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+					address(1);
+					return 2;
+				}
+				// Unknown opcodes, and `OPCODE_END` anywhere but at the end.
+				return 0;
+			}
+		}
+	}
+
+	bool check(GDScriptFunction *p_function) {
+		function = p_function;
+		code = p_function->_code_ptr;
+		code_size = p_function->_code_size;
+		address_limits[GDScriptFunction::ADDR_TYPE_STACK] = p_function->_stack_size;
+		address_limits[GDScriptFunction::ADDR_TYPE_CONSTANT] = p_function->_constant_count;
+		address_limits[GDScriptFunction::ADDR_TYPE_MEMBER] = p_function->_script->member_indices.size();
+
+		// Fixed addresses and arguments live at the start of the stack.
+		if (p_function->_stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX + p_function->_argument_count || p_function->_instruction_args_size < 0) {
+			return false;
+		}
+		if (p_function->_default_arg_count > p_function->_argument_count) {
+			return false;
+		}
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			if (E.key < GDScriptFunction::FIXED_ADDRESSES_MAX || E.key >= p_function->_stack_size || E.value < 0 || E.value >= Variant::VARIANT_MAX) {
+				return false;
+			}
+		}
+		for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+			if (stack_debug.pos < 0 || stack_debug.pos >= p_function->_stack_size) {
+				return false;
+			}
+		}
+
+		LocalVector<bool> instruction_starts;
+		instruction_starts.resize(code_size);
+		for (int i = 0; i < code_size; i++) {
+			instruction_starts[i] = false;
+		}
+
+		ip = 0;
+		while (valid && ip < code_size - 1) {
+			instruction_starts[ip] = true;
+			const int size = check_instruction();
+			if (size <= 0 || ip + size > code_size) {
+				return false;
+			}
+			ip += size;
+		}
+		if (!valid || ip != code_size - 1 || code[ip] != GDScriptFunction::OPCODE_END) {
+			return false;
+		}
+		instruction_starts[ip] = true;
+
+		for (int i = 0; i < p_function->default_arguments.size(); i++) {
+			jump_targets.push_back(p_function->default_arguments[i]);
+		}
+		for (int target : jump_targets) {
+			if (target < 0 || target >= code_size || !instruction_starts[target]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+struct GDScriptBytecodeCache::Writer {
+	Vector<uint8_t> data;
+	// Other script files the written data refers to.
+	HashSet<String> scripts;
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		const int pos = data.size();
+		data.resize(pos + 4);
+		encode_uint32(p_value, data.ptrw() + pos);
+	}
+
+	void put_buffer(const uint8_t *p_buffer, int p_size) {
+		const int pos = data.size();
+		data.resize(pos + p_size);
+		memcpy(data.ptrw() + pos, p_buffer, p_size);
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		put_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	bool put_var(const Variant &p_value) {
+		int len = 0;
+		if (encode_variant(p_value, nullptr, len, false) != OK) {
+			return false;
+		}
+		const int pos = data.size();
+		data.resize(pos + len);
+		return encode_variant(p_value, data.ptrw() + pos, len, false) == OK;
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	bool failed = false;
+
+	uint8_t get_u8() {
+		if (pos + 1 > size) {
+			failed = true;
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (pos + 4 > size) {
+			failed = true;
+			return 0;
+		}
+		const uint32_t value = decode_uint32(data + pos);
+		pos += 4;
+		return value;
+	}
+
+	// Element counts, every element takes at least one byte.
+	uint32_t get_count() {
+		const uint32_t count = get_u32();
+		if (count > uint32_t(size - pos)) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		const uint32_t len = get_count();
+		if (failed) {
+			return String();
+		}
+		String string;
+		string.parse_utf8((const char *)data + pos, len);
+		pos += len;
+		return string;
+	}
+
+	StringName get_string_name() {
+		return StringName(get_string());
+	}
+
+	Variant get_var() {
+		Variant value;
+		int len = 0;
+		if (failed || decode_variant(value, data + pos, size - pos, &len, false) != OK) {
+			failed = true;
+			return Variant();
+		}
+		pos += len;
+		return value;
+	}
+
+	Reader(const Vector<uint8_t> &p_data) {
+		data = p_data.ptr();
+		size = p_data.size();
+	}
+};
+
+Mutex GDScriptBytecodeCache::mutex;
+String GDScriptBytecodeCache::build_key;
+uint32_t GDScriptBytecodeCache::globals_hash = 0;
+int GDScriptBytecodeCache::globals_hash_count = -1;
+HashMap<String, String> GDScriptBytecodeCache::file_hashes;
+
+bool GDScriptBytecodeCache::is_enabled() {
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+	return GLOBAL_GET("gdscript/bytecode_cache/enabled");
+}
+
+String GDScriptBytecodeCache::get_build_key() {
+	MutexLock lock(mutex);
+
+	if (!build_key.is_empty()) {
+		return build_key;
+	}
+
+	build_key = vformat("%s|%s|%d|%d|%d|%d", VERSION_FULL_BUILD, VERSION_HASH, FORMAT_VERSION, GDScriptFunction::OPCODE_END, Variant::VARIANT_MAX, Variant::OP_MAX);
+#ifdef DEBUG_ENABLED
+	build_key += "|debug";
+#endif
+#ifdef TOOLS_ENABLED
+	build_key += "|tools";
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	build_key += "|double";
+#endif
+	if (GDScriptCompiler::is_optimizing()) {
+		build_key += "|optimize";
+	}
+	return build_key;
+}
+
+uint32_t GDScriptBytecodeCache::_get_globals_hash() {
+	MutexLock lock(mutex);
+
+	// Compiled code refers to globals by their index.
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	if (globals_hash_count != language->get_global_array_size()) {
+		uint32_t hash = HASH_MURMUR3_SEED;
+		for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+			hash = hash_murmur3_one_32(E.key.hash(), hash);
+			hash = hash_murmur3_one_32(E.value, hash);
+		}
+		globals_hash = hash_fmix32(hash);
+		globals_hash_count = language->get_global_array_size();
+	}
+	return globals_hash;
+}
+
+void GDScriptBytecodeCache::clear() {
+	MutexLock lock(mutex);
+
+	if (function_symbols) {
+		memdelete(function_symbols);
+		function_symbols = nullptr;
+	}
+	build_key = String();
+	globals_hash = 0;
+	globals_hash_count = -1;
+	file_hashes.clear();
+}
+
+String GDScriptBytecodeCache::_get_file_hash(const String &p_path) {
+	{
+		MutexLock lock(mutex);
+		if (const String *hash = file_hashes.getptr(p_path)) {
+			return *hash;
+		}
+	}
+
+	String hash;
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (FileAccess::exists(remapped_path)) {
+		hash = FileAccess::get_md5(remapped_path);
+	}
+
+	MutexLock lock(mutex);
+	file_hashes[p_path] = hash;
+	return hash;
+}
+
+String GDScriptBytecodeCache::_get_cache_file(const String &p_path) {
+	const String directory = GLOBAL_GET("gdscript/bytecode_cache/directory");
+	return directory.path_join(p_path.md5_text() + ".gdbc");
+}
+
+bool GDScriptBytecodeCache::_write_script_ref(Writer &p_writer, const Script *p_script, const GDScript *p_root) {
+	const GDScript *script = Object::cast_to<GDScript>(p_script);
+	if (script == nullptr) {
+		return false;
+	}
+
+	Vector<StringName> class_names;
+	const GDScript *root = script;
+	while (root->_owner != nullptr) {
+		class_names.push_back(root->local_name);
+		root = root->_owner;
+	}
+
+	p_writer.put_u8(root == p_root);
+	if (root != p_root) {
+		const String path = root->get_script_path();
+		if (path.is_empty() || path.contains("::")) {
+			return false; // Built-in scripts can't be found again.
+		}
+		p_writer.put_string(path);
+		p_writer.scripts.insert(path);
+	}
+
+	p_writer.put_u32(class_names.size());
+	for (int i = class_names.size() - 1; i >= 0; i--) {
+		p_writer.put_string(class_names[i]);
+	}
+	return true;
+}
+
+Ref<Script> GDScriptBytecodeCache::_read_script_ref(Reader &p_reader, GDScript *p_root, bool &r_local) {
+	r_local = p_reader.get_u8();
+
+	GDScript *script = p_root;
+	Ref<GDScript> root;
+	if (!r_local) {
+		const String path = p_reader.get_string();
+		if (p_reader.failed) {
+			return Ref<Script>();
+		}
+		Error err = OK;
+		root = GDScriptCache::get_shallow_script(path, err, p_root->get_script_path());
+		if (err != OK || root.is_null()) {
+			p_reader.failed = true;
+			return Ref<Script>();
+		}
+		script = root.ptr();
+	}
+
+	const uint32_t depth = p_reader.get_count();
+	for (uint32_t i = 0; i < depth && !p_reader.failed; i++) {
+		HashMap<StringName, Ref<GDScript>>::Iterator E = script->subclasses.find(p_reader.get_string_name());
+		if (!E) {
+			p_reader.failed = true;
+			return Ref<Script>();
+		}
+		script = E->value.ptr();
+	}
+
+	return p_reader.failed ? Ref<Script>() : Ref<Script>(script);
+}
+
+static StringName _get_global_object_name(const Object *p_object) {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	const Variant *globals = language->get_global_array();
+	for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+		if (globals[E.value].get_type() == Variant::OBJECT && globals[E.value].get_validated_object() == p_object) {
+			return E.key;
+		}
+	}
+	return StringName();
+}
+
+bool GDScriptBytecodeCache::_write_constant(Writer &p_writer, const Variant &p_value, const GDScript *p_root) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			const Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_u8(CONSTANT_NULL_OBJECT);
+				return true;
+			}
+
+			if (Object::cast_to<GDScript>(object)) {
+				p_writer.put_u8(CONSTANT_SCRIPT);
+				return _write_script_ref(p_writer, Object::cast_to<GDScript>(object), p_root);
+			}
+
+			const StringName global_name = _get_global_object_name(object);
+			if (global_name != StringName()) {
+				p_writer.put_u8(CONSTANT_GLOBAL);
+				p_writer.put_string(global_name);
+				return true;
+			}
+
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource && !resource->get_path().is_empty() && !resource->is_built_in()) {
+				p_writer.put_u8(CONSTANT_RESOURCE);
+				p_writer.put_string(resource->get_path());
+				return true;
+			}
+
+			return false;
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			p_writer.put_u8(CONSTANT_ARRAY);
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			if (!_write_constant(p_writer, array.get_typed_script(), p_root)) {
+				return false;
+			}
+			p_writer.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				if (!_write_constant(p_writer, array[i], p_root)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			p_writer.put_u8(CONSTANT_DICTIONARY);
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u8(dictionary.is_typed());
+			if (dictionary.is_typed()) {
+				p_writer.put_u32(dictionary.get_typed_key_builtin());
+				p_writer.put_string(dictionary.get_typed_key_class_name());
+				if (!_write_constant(p_writer, dictionary.get_typed_key_script(), p_root)) {
+					return false;
+				}
+				p_writer.put_u32(dictionary.get_typed_value_builtin());
+				p_writer.put_string(dictionary.get_typed_value_class_name());
+				if (!_write_constant(p_writer, dictionary.get_typed_value_script(), p_root)) {
+					return false;
+				}
+			}
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			p_writer.put_u32(keys.size());
+			for (const Variant &key : keys) {
+				if (!_write_constant(p_writer, key, p_root) || !_write_constant(p_writer, dictionary[key], p_root)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID: {
+			return false; // Only valid while running.
+		}
+		default: {
+			p_writer.put_u8(CONSTANT_VALUE);
+			return p_writer.put_var(p_value);
+		}
+	}
+}
+
+Variant GDScriptBytecodeCache::_read_constant(Reader &p_reader, GDScript *p_root) {
+	switch (p_reader.get_u8()) {
+		case CONSTANT_VALUE: {
+			return p_reader.get_var();
+		}
+		case CONSTANT_NULL_OBJECT: {
+			return Variant((Object *)nullptr);
+		}
+		case CONSTANT_GLOBAL: {
+			const StringName name = p_reader.get_string_name();
+			GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+			const int *index = language->get_global_map().getptr(name);
+			if (index == nullptr) {
+				p_reader.failed = true;
+				return Variant();
+			}
+			return language->get_global_array()[*index];
+		}
+		case CONSTANT_SCRIPT: {
+			bool local = false;
+			return _read_script_ref(p_reader, p_root, local);
+		}
+		case CONSTANT_RESOURCE: {
+			const String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return Variant();
+			}
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				p_reader.failed = true;
+			}
+			return resource;
+		}
+		case CONSTANT_ARRAY: {
+			const bool read_only = p_reader.get_u8();
+			const uint32_t builtin_type = p_reader.get_u32();
+			const StringName class_name = p_reader.get_string_name();
+			const Variant script = _read_constant(p_reader, p_root);
+			const uint32_t size = p_reader.get_count();
+			if (p_reader.failed || builtin_type >= Variant::VARIANT_MAX) {
+				p_reader.failed = true;
+				return Variant();
+			}
+
+			Array array;
+			if (builtin_type != Variant::NIL) {
+				array.set_typed(builtin_type, class_name, script);
+			}
+			array.resize(size);
+			for (uint32_t i = 0; i < size && !p_reader.failed; i++) {
+				array[i] = _read_constant(p_reader, p_root);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case CONSTANT_DICTIONARY: {
+			const bool read_only = p_reader.get_u8();
+			Dictionary dictionary;
+			if (p_reader.get_u8()) {
+				const uint32_t key_type = p_reader.get_u32();
+				const StringName key_class_name = p_reader.get_string_name();
+				const Variant key_script = _read_constant(p_reader, p_root);
+				const uint32_t value_type = p_reader.get_u32();
+				const StringName value_class_name = p_reader.get_string_name();
+				const Variant value_script = _read_constant(p_reader, p_root);
+				if (p_reader.failed || key_type >= Variant::VARIANT_MAX || value_type >= Variant::VARIANT_MAX) {
+					p_reader.failed = true;
+					return Variant();
+				}
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			const uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_reader.failed; i++) {
+				const Variant key = _read_constant(p_reader, p_root);
+				dictionary[key] = _read_constant(p_reader, p_root);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		default: {
+			p_reader.failed = true;
+			return Variant();
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type, const GDScript *p_root) {
+	p_writer.put_u8(p_type.has_type);
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	if (!_write_constant(p_writer, Variant(p_type.script_type), p_root)) {
+		return false;
+	}
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		if (!_write_data_type(p_writer, element_type, p_root)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+GDScriptDataType GDScriptBytecodeCache::_read_data_type(Reader &p_reader, GDScript *p_root) {
+	GDScriptDataType type;
+	type.has_type = p_reader.get_u8();
+	type.kind = GDScriptDataType::Kind(p_reader.get_u8());
+	type.builtin_type = Variant::Type(p_reader.get_u32());
+	type.native_type = p_reader.get_string_name();
+	if (type.kind > GDScriptDataType::GDSCRIPT || type.builtin_type >= Variant::VARIANT_MAX) {
+		p_reader.failed = true;
+		return GDScriptDataType();
+	}
+
+	const Variant script_value = _read_constant(p_reader, p_root);
+	Script *script = Object::cast_to<Script>(script_value);
+	if (script) {
+		type.script_type = script;
+		// Like the compiler, only hold a strong reference to classes of other files.
+		GDScript *gdscript = Object::cast_to<GDScript>(script);
+		if (type.kind != GDScriptDataType::GDSCRIPT || gdscript == nullptr || gdscript->get_root_script() != p_root) {
+			type.script_type_ref = Ref<Script>(script);
+		}
+	}
+
+	const uint32_t element_count = p_reader.get_count();
+	for (uint32_t i = 0; i < element_count && !p_reader.failed; i++) {
+		type.set_container_element_type(i, _read_data_type(p_reader, p_root));
+	}
+	return type;
+}
+
+bool GDScriptBytecodeCache::_write_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_u32(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_u32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_u32(p_info.usage);
+	return true;
+}
+
+PropertyInfo GDScriptBytecodeCache::_read_property_info(Reader &p_reader) {
+	PropertyInfo info;
+	info.type = Variant::Type(p_reader.get_u32());
+	info.name = p_reader.get_string();
+	info.class_name = p_reader.get_string_name();
+	info.hint = PropertyHint(p_reader.get_u32());
+	info.hint_string = p_reader.get_string();
+	info.usage = p_reader.get_u32();
+	if (info.type >= Variant::VARIANT_MAX) {
+		p_reader.failed = true;
+	}
+	return info;
+}
+
+bool GDScriptBytecodeCache::_write_method_info(Writer &p_writer, const MethodInfo &p_info, const GDScript *p_root) {
+	p_writer.put_string(p_info.name);
+	p_writer.put_u32(p_info.flags);
+	p_writer.put_u32(p_info.id);
+	_write_property_info(p_writer, p_info.return_val);
+	p_writer.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_write_property_info(p_writer, argument);
+	}
+	p_writer.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		if (!_write_constant(p_writer, default_argument, p_root)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+MethodInfo GDScriptBytecodeCache::_read_method_info(Reader &p_reader, GDScript *p_root) {
+	MethodInfo info;
+	info.name = p_reader.get_string();
+	info.flags = p_reader.get_u32();
+	info.id = p_reader.get_u32();
+	info.return_val = _read_property_info(p_reader);
+	const uint32_t argument_count = p_reader.get_count();
+	for (uint32_t i = 0; i < argument_count && !p_reader.failed; i++) {
+		info.arguments.push_back(_read_property_info(p_reader));
+	}
+	const uint32_t default_argument_count = p_reader.get_count();
+	for (uint32_t i = 0; i < default_argument_count && !p_reader.failed; i++) {
+		info.default_arguments.push_back(_read_constant(p_reader, p_root));
+	}
+	return info;
+}
+
+bool GDScriptBytecodeCache::_write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info, const GDScript *p_root) {
+	p_writer.put_u32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	return _write_data_type(p_writer, p_info.data_type, p_root) && _write_property_info(p_writer, p_info.property_info);
+}
+
+GDScript::MemberInfo GDScriptBytecodeCache::_read_member_info(Reader &p_reader, GDScript *p_root) {
+	GDScript::MemberInfo info;
+	info.index = p_reader.get_u32();
+	info.setter = p_reader.get_string_name();
+	info.getter = p_reader.get_string_name();
+	info.data_type = _read_data_type(p_reader, p_root);
+	info.property_info = _read_property_info(p_reader);
+	return info;
+}
+
+bool GDScriptBytecodeCache::_write_function(Writer &p_writer, const GDScriptFunction *p_function, const GDScript *p_root) {
+	const GDScriptFunctionSymbols &symbols = *function_symbols;
+
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	p_writer.put_u32(p_function->_initial_line);
+	if (!_write_constant(p_writer, p_function->rpc_config, p_root) || !_write_data_type(p_writer, p_function->return_type, p_root) || !_write_method_info(p_writer, p_function->method_info, p_root)) {
+		return false;
+	}
+
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		if (!_write_data_type(p_writer, argument_type, p_root)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (int default_argument : p_function->default_arguments) {
+		p_writer.put_u32(default_argument);
+	}
+
+	p_writer.put_u32(p_function->code.size());
+	for (int code : p_function->code) {
+		p_writer.put_u32(code);
+	}
+	p_writer.put_u32(p_function->_stack_size);
+	p_writer.put_u32(p_function->_instruction_args_size);
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_u32(E.key);
+		p_writer.put_u32(E.value);
+	}
+	p_writer.put_u32(p_function->line_mappings.size());
+	for (const GDScriptFunction::LineMapping &mapping : p_function->line_mappings) {
+		p_writer.put_u32(mapping.ip);
+		p_writer.put_u32(mapping.line);
+	}
+
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_write_constant(p_writer, constant, p_root)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const GDScriptFunctionSymbols::Operator *op = _find_symbol(symbols.operators, evaluator);
+		if (op == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(op->op);
+		p_writer.put_u32(op->left);
+		p_writer.put_u32(op->right);
+	}
+	p_writer.put_u32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		const GDScriptFunctionSymbols::Member *member = _find_symbol(symbols.setters, setter);
+		if (member == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(member->type);
+		p_writer.put_string(member->name);
+	}
+	p_writer.put_u32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		const GDScriptFunctionSymbols::Member *member = _find_symbol(symbols.getters, getter);
+		if (member == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(member->type);
+		p_writer.put_string(member->name);
+	}
+	p_writer.put_u32(p_function->keyed_setters.size());
+	for (Variant::ValidatedKeyedSetter setter : p_function->keyed_setters) {
+		const Variant::Type *type = _find_symbol(symbols.keyed_setters, setter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(*type);
+	}
+	p_writer.put_u32(p_function->keyed_getters.size());
+	for (Variant::ValidatedKeyedGetter getter : p_function->keyed_getters) {
+		const Variant::Type *type = _find_symbol(symbols.keyed_getters, getter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(*type);
+	}
+	p_writer.put_u32(p_function->indexed_setters.size());
+	for (Variant::ValidatedIndexedSetter setter : p_function->indexed_setters) {
+		const Variant::Type *type = _find_symbol(symbols.indexed_setters, setter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(*type);
+	}
+	p_writer.put_u32(p_function->indexed_getters.size());
+	for (Variant::ValidatedIndexedGetter getter : p_function->indexed_getters) {
+		const Variant::Type *type = _find_symbol(symbols.indexed_getters, getter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(*type);
+	}
+	p_writer.put_u32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+		const GDScriptFunctionSymbols::Member *member = _find_symbol(symbols.builtin_methods, method);
+		if (member == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(member->type);
+		p_writer.put_string(member->name);
+	}
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const GDScriptFunctionSymbols::Constructor *symbol = _find_symbol(symbols.constructors, constructor);
+		if (symbol == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(symbol->type);
+		p_writer.put_u32(symbol->index);
+	}
+	p_writer.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *name = _find_symbol(symbols.utilities, utility);
+		if (name == nullptr) {
+			return false;
+		}
+		p_writer.put_string(*name);
+	}
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr gds_utility : p_function->gds_utilities) {
+		const StringName *name = _find_symbol(symbols.gds_utilities, gds_utility);
+		if (name == nullptr) {
+			return false;
+		}
+		p_writer.put_string(*name);
+	}
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+	}
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = p_function->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		if (info == nullptr) {
+			return false;
+		}
+		p_writer.put_u32(info->capture_count);
+		p_writer.put_u8(info->use_self);
+		if (!_write_function(p_writer, lambda, p_root)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_function->_inline_caches_count);
+
+	p_writer.put_u32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+		p_writer.put_u32(stack_debug.line);
+		p_writer.put_u32(stack_debug.pos);
+		p_writer.put_u8(stack_debug.added);
+		p_writer.put_string(stack_debug.identifier);
+	}
+
+#ifdef DEBUG_ENABLED
+	p_writer.put_string(p_function->profile.signature);
+	for (const Vector<String> *names : { &p_function->operator_names, &p_function->setter_names, &p_function->getter_names, &p_function->builtin_methods_names, &p_function->constructors_names, &p_function->utilities_names, &p_function->gds_utilities_names }) {
+		p_writer.put_u32(names->size());
+		for (const String &name : *names) {
+			p_writer.put_string(name);
+		}
+	}
+#endif
+
+	return true;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &p_reader, GDScript *p_script, GDScript *p_root) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+
+	function->name = p_reader.get_string_name();
+	function->_static = p_reader.get_u8();
+	function->_initial_line = p_reader.get_u32();
+	function->rpc_config = _read_constant(p_reader, p_root);
+	function->return_type = _read_data_type(p_reader, p_root);
+	function->method_info = _read_method_info(p_reader, p_root);
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		function->argument_types.push_back(_read_data_type(p_reader, p_root));
+	}
+	function->_argument_count = function->argument_types.size();
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		function->default_arguments.push_back(p_reader.get_u32());
+	}
+
+	count = p_reader.get_count();
+	function->code.resize(count);
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		function->code.write[i] = p_reader.get_u32();
+	}
+	function->_stack_size = p_reader.get_u32();
+	function->_instruction_args_size = p_reader.get_u32();
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const int slot = p_reader.get_u32();
+		function->temporary_slots[slot] = Variant::Type(p_reader.get_u32());
+	}
+	count = p_reader.get_count();
+	function->line_mappings.resize(count);
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		GDScriptFunction::LineMapping &mapping = function->line_mappings.write[i];
+		mapping.ip = p_reader.get_u32();
+		mapping.line = p_reader.get_u32();
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		function->constants.push_back(_read_constant(p_reader, p_root));
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		function->global_names.push_back(p_reader.get_string_name());
+	}
+
+	// Function pointers are resolved again, any that no longer exists invalidates the whole entry.
+	bool resolved = true;
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Operator op = Variant::Operator(p_reader.get_u32());
+		const Variant::Type left = Variant::Type(p_reader.get_u32());
+		const Variant::Type right = Variant::Type(p_reader.get_u32());
+		Variant::ValidatedOperatorEvaluator evaluator = nullptr;
+		if (op < Variant::OP_MAX && left < Variant::VARIANT_MAX && right < Variant::VARIANT_MAX) {
+			evaluator = Variant::get_validated_operator_evaluator(op, left, right);
+		}
+		resolved = resolved && evaluator;
+		function->operator_funcs.push_back(evaluator);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		const StringName member = p_reader.get_string_name();
+		Variant::ValidatedSetter setter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_setter(type, member) : nullptr;
+		resolved = resolved && setter;
+		function->setters.push_back(setter);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		const StringName member = p_reader.get_string_name();
+		Variant::ValidatedGetter getter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_getter(type, member) : nullptr;
+		resolved = resolved && getter;
+		function->getters.push_back(getter);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		Variant::ValidatedKeyedSetter setter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_setter(type) : nullptr;
+		resolved = resolved && setter;
+		function->keyed_setters.push_back(setter);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		Variant::ValidatedKeyedGetter getter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_getter(type) : nullptr;
+		resolved = resolved && getter;
+		function->keyed_getters.push_back(getter);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		Variant::ValidatedIndexedSetter setter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_setter(type) : nullptr;
+		resolved = resolved && setter;
+		function->indexed_setters.push_back(setter);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		Variant::ValidatedIndexedGetter getter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_getter(type) : nullptr;
+		resolved = resolved && getter;
+		function->indexed_getters.push_back(getter);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		const StringName name = p_reader.get_string_name();
+		Variant::ValidatedBuiltInMethod method = type < Variant::VARIANT_MAX ? Variant::get_validated_builtin_method(type, name) : nullptr;
+		resolved = resolved && method;
+		function->builtin_methods.push_back(method);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const Variant::Type type = Variant::Type(p_reader.get_u32());
+		const int index = p_reader.get_u32();
+		Variant::ValidatedConstructor constructor = nullptr;
+		if (type < Variant::VARIANT_MAX && index >= 0 && index < Variant::get_constructor_count(type)) {
+			constructor = Variant::get_validated_constructor(type, index);
+		}
+		resolved = resolved && constructor;
+		function->constructors.push_back(constructor);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(p_reader.get_string_name());
+		resolved = resolved && utility;
+		function->utilities.push_back(utility);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		GDScriptUtilityFunctions::FunctionPtr gds_utility = GDScriptUtilityFunctions::get_function(p_reader.get_string_name());
+		resolved = resolved && gds_utility;
+		function->gds_utilities.push_back(gds_utility);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const StringName class_name = p_reader.get_string_name();
+		MethodBind *method = ClassDB::get_method(class_name, p_reader.get_string_name());
+		resolved = resolved && method;
+		function->methods.push_back(method);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed && resolved; i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_u32();
+		info.use_self = p_reader.get_u8();
+		GDScriptFunction *lambda = _read_function(p_reader, p_script, p_root);
+		if (lambda == nullptr) {
+			resolved = false;
+			break;
+		}
+		function->lambdas.push_back(lambda);
+		p_script->lambda_info.insert(lambda, info);
+	}
+
+	const int inline_cache_count = p_reader.get_u32();
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = p_reader.get_u32();
+		stack_debug.pos = p_reader.get_u32();
+		stack_debug.added = p_reader.get_u8();
+		stack_debug.identifier = p_reader.get_string_name();
+		function->stack_debug.push_back(stack_debug);
+	}
+
+#ifdef DEBUG_ENABLED
+	function->profile.signature = p_reader.get_string_name();
+	for (Vector<String> *names : { &function->operator_names, &function->setter_names, &function->getter_names, &function->builtin_methods_names, &function->constructors_names, &function->utilities_names, &function->gds_utilities_names }) {
+		count = p_reader.get_count();
+		for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+			names->push_back(p_reader.get_string());
+		}
+	}
+#endif
+
+	if (p_reader.failed || !resolved || inline_cache_count < 0) {
+		for (GDScriptFunction *lambda : function->lambdas) {
+			p_script->lambda_info.erase(lambda);
+		}
+		memdelete(function);
+		return nullptr;
+	}
+
+	// Same layout `GDScriptByteCodeGenerator::write_end()` produces.
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+	function->_code_size = function->code.size();
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_constant_count = function->constants.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+	function->_global_names_count = function->global_names.size();
+	function->_operator_funcs_ptr = function->operator_funcs.is_empty() ? nullptr : function->operator_funcs.ptr();
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_setters_ptr = function->setters.is_empty() ? nullptr : function->setters.ptr();
+	function->_setters_count = function->setters.size();
+	function->_getters_ptr = function->getters.is_empty() ? nullptr : function->getters.ptr();
+	function->_getters_count = function->getters.size();
+	function->_keyed_setters_ptr = function->keyed_setters.is_empty() ? nullptr : function->keyed_setters.ptr();
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_getters_ptr = function->keyed_getters.is_empty() ? nullptr : function->keyed_getters.ptr();
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_indexed_setters_ptr = function->indexed_setters.is_empty() ? nullptr : function->indexed_setters.ptr();
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_getters_ptr = function->indexed_getters.is_empty() ? nullptr : function->indexed_getters.ptr();
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_builtin_methods_ptr = function->builtin_methods.is_empty() ? nullptr : function->builtin_methods.ptr();
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_constructors_ptr = function->constructors.is_empty() ? nullptr : function->constructors.ptr();
+	function->_constructors_count = function->constructors.size();
+	function->_utilities_ptr = function->utilities.is_empty() ? nullptr : function->utilities.ptr();
+	function->_utilities_count = function->utilities.size();
+	function->_gds_utilities_ptr = function->gds_utilities.is_empty() ? nullptr : function->gds_utilities.ptr();
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+	function->_methods_count = function->methods.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	if (inline_cache_count > 0) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	}
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_write_skeleton(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		_write_skeleton(p_writer, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_read_skeleton(Reader &p_reader, GDScript *p_script) {
+	// Mirrors `GDScriptCompiler::make_scripts()`, keeping existing inner class objects.
+	p_script->fully_qualified_name = p_reader.get_string();
+	p_script->local_name = p_reader.get_string_name();
+	p_script->global_name = p_reader.get_string_name();
+	p_script->simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	const uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string_name();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_read_skeleton(p_reader, subclass.ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::_write_class(Writer &p_writer, const GDScript *p_script, const GDScript *p_root) {
+	p_writer.put_u8(p_script->tool);
+	p_writer.put_string(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+	if (!_write_constant(p_writer, p_script->base, p_root)) {
+		return false;
+	}
+
+	p_writer.put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		p_writer.put_string(E.key);
+		if (!_write_member_info(p_writer, E.value, p_root)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string(member);
+	}
+	p_writer.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		p_writer.put_string(E.key);
+		if (!_write_member_info(p_writer, E.value, p_root)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		if (!_write_constant(p_writer, E.value, p_root)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		if (!_write_method_info(p_writer, E.value, p_root)) {
+			return false;
+		}
+	}
+	if (!_write_constant(p_writer, p_script->rpc_config, p_root)) {
+		return false;
+	}
+
+#ifdef TOOLS_ENABLED
+	p_writer.put_u32(p_script->member_default_values.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+		p_writer.put_string(E.key);
+		if (!_write_constant(p_writer, E.value, p_root)) {
+			return false;
+		}
+	}
+#endif
+
+	p_writer.put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		if (!_write_function(p_writer, E.value, p_root)) {
+			return false;
+		}
+	}
+	for (const GDScriptFunction *function : { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer }) {
+		p_writer.put_u8(function != nullptr);
+		if (function && !_write_function(p_writer, function, p_root)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		if (!_write_class(p_writer, E.value.ptr(), p_root)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_read_class(Reader &p_reader, GDScript *p_script, GDScript *p_root) {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+	p_script->tool = p_reader.get_u8();
+	const int *native_index = language->get_global_map().getptr(p_reader.get_string_name());
+	if (native_index == nullptr) {
+		return false;
+	}
+	p_script->native = language->get_global_array()[*native_index];
+	if (p_script->native.is_null()) {
+		return false;
+	}
+
+	Ref<GDScript> base = _read_constant(p_reader, p_root);
+	p_script->base = base;
+	p_script->_base = base.ptr();
+
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string_name();
+		p_script->member_indices[name] = _read_member_info(p_reader, p_root);
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		p_script->members.insert(p_reader.get_string_name());
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string_name();
+		p_script->static_variables_indices[name] = _read_member_info(p_reader, p_root);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string_name();
+		p_script->constants.insert(name, _read_constant(p_reader, p_root));
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string_name();
+		p_script->_signals[name] = _read_method_info(p_reader, p_root);
+	}
+	p_script->rpc_config = _read_constant(p_reader, p_root);
+
+#ifdef TOOLS_ENABLED
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string_name();
+		p_script->member_default_values[name] = _read_constant(p_reader, p_root);
+	}
+#endif
+
+	if (p_reader.failed) {
+		return false;
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		GDScriptFunction *function = _read_function(p_reader, p_script, p_root);
+		if (function == nullptr) {
+			return false;
+		}
+		p_script->member_functions[function->get_name()] = function;
+	}
+	if (HashMap<StringName, GDScriptFunction *>::Iterator E = p_script->member_functions.find(language->strings._init)) {
+		p_script->initializer = E->value;
+	}
+	for (GDScriptFunction **function : { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer }) {
+		if (p_reader.get_u8()) {
+			*function = _read_function(p_reader, p_script, p_root);
+			if (*function == nullptr) {
+				return false;
+			}
+		}
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+		HashMap<StringName, Ref<GDScript>>::Iterator E = p_script->subclasses.find(p_reader.get_string_name());
+		if (!E || !_read_class(p_reader, E->value.ptr(), p_root)) {
+			return false;
+		}
+	}
+
+	if (p_reader.failed) {
+		return false;
+	}
+
+	p_script->_static_default_init();
+	p_script->valid = true;
+	return true;
+}
+
+bool GDScriptBytecodeCache::_validate_function(GDScriptFunction *p_function) {
+	CodeValidator validator;
+	if (!validator.check(p_function)) {
+		return false;
+	}
+	for (GDScriptFunction *lambda : p_function->lambdas) {
+		if (!_validate_function(lambda)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_validate_class(GDScript *p_script) {
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		if (!_validate_function(E.value)) {
+			return false;
+		}
+	}
+	for (GDScriptFunction *function : { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer }) {
+		if (function && !_validate_function(function)) {
+			return false;
+		}
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (!_validate_class(E.value.ptr())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_read_header(Reader &p_reader, bool p_check_sources, const String &p_path, bool &r_static_script) {
+	if (p_reader.size < 4 || memcmp(p_reader.data, BYTECODE_CACHE_MAGIC, 4) != 0) {
+		return false;
+	}
+	p_reader.pos = 4;
+	if (p_reader.get_u32() != FORMAT_VERSION || p_reader.get_string() != get_build_key() || p_reader.get_u32() != _get_globals_hash()) {
+		return false;
+	}
+
+	const String source_hash = p_reader.get_string();
+	if (p_check_sources && source_hash != _get_file_hash(p_path)) {
+		return false;
+	}
+	const uint32_t dependency_count = p_reader.get_count();
+	for (uint32_t i = 0; i < dependency_count && !p_reader.failed; i++) {
+		const String path = p_reader.get_string();
+		const String hash = p_reader.get_string();
+		if (p_check_sources && hash != _get_file_hash(path)) {
+			return false;
+		}
+	}
+
+	r_static_script = p_reader.get_u8();
+
+	// Everything after the header is covered by its hash.
+	uint8_t hash[32];
+	if (p_reader.failed || p_reader.pos + 32 > p_reader.size) {
+		return false;
+	}
+	if (CryptoCore::sha256(p_reader.data + p_reader.pos + 32, p_reader.size - p_reader.pos - 32, hash) != OK || memcmp(hash, p_reader.data + p_reader.pos, 32) != 0) {
+		return false;
+	}
+	p_reader.pos += 32;
+	return true;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::serialize(const GDScript *p_script, const HashSet<String> &p_dependencies) {
+	ERR_FAIL_COND_V(!p_script->valid, Vector<uint8_t>());
+
+	{
+		MutexLock lock(mutex);
+		if (function_symbols == nullptr) {
+			function_symbols = memnew(GDScriptFunctionSymbols);
+		}
+	}
+
+	Writer body;
+	_write_skeleton(body, p_script);
+	if (!_write_class(body, p_script, p_script)) {
+		return Vector<uint8_t>();
+	}
+
+	const String path = p_script->get_script_path();
+	HashSet<String> dependencies = p_dependencies;
+	for (const String &script : body.scripts) {
+		dependencies.insert(script);
+	}
+	dependencies.erase(path);
+
+	Writer writer;
+	writer.put_buffer((const uint8_t *)BYTECODE_CACHE_MAGIC, 4);
+	writer.put_u32(FORMAT_VERSION);
+	writer.put_string(get_build_key());
+	writer.put_u32(_get_globals_hash());
+	writer.put_string(path.is_empty() ? String() : _get_file_hash(path));
+	writer.put_u32(dependencies.size());
+	for (const String &dependency : dependencies) {
+		writer.put_string(dependency);
+		writer.put_string(_get_file_hash(dependency));
+	}
+	writer.put_u8(GDScriptCache::has_static_script(p_script->get_fully_qualified_name()));
+
+	uint8_t hash[32];
+	if (CryptoCore::sha256(body.data.ptr(), body.data.size(), hash) != OK) {
+		return Vector<uint8_t>();
+	}
+	writer.put_buffer(hash, 32);
+	writer.put_buffer(body.data.ptr(), body.data.size());
+	return writer.data;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_data, bool p_check_sources) {
+	ERR_FAIL_COND_V_MSG(!p_script->member_functions.is_empty() || p_script->implicit_initializer, ERR_ALREADY_IN_USE, "Bytecode can only be loaded into scripts that weren't compiled yet.");
+
+	const String path = p_script->get_script_path();
+	Reader reader(p_data);
+	bool static_script = false;
+	if (!_read_header(reader, p_check_sources, path, static_script)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	_read_skeleton(reader, p_script);
+	p_script->_owner = nullptr;
+	GDScriptFunction::invalidate_inline_caches();
+
+	// Code is checked once every class is read, static variable accesses may refer to any of them.
+	if (reader.failed || !_read_class(reader, p_script, p_script) || !_validate_class(p_script)) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	if (static_script) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	if (!path.is_empty()) {
+		// Compile the scripts this one refers to, same as the compiler does.
+		return GDScriptCache::finish_compiling(path);
+	}
+	return OK;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script) {
+	const String path = p_script->get_script_path();
+	if (path.is_empty() || path.contains("::")) {
+		return ERR_UNAVAILABLE;
+	}
+
+	const String cache_file = _get_cache_file(path);
+	if (!FileAccess::exists(cache_file)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	Error err = OK;
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_file, &err);
+	if (err != OK) {
+		return err;
+	}
+
+	Reader reader(data);
+	bool static_script = false;
+	if (!_read_header(reader, true, path, static_script)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	_read_skeleton(reader, p_script);
+	if (reader.failed) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	p_script->cached_bytecode = data;
+	return OK;
+}
+
+Error GDScriptBytecodeCache::load_script(GDScript *p_script) {
+	Vector<uint8_t> data = p_script->cached_bytecode;
+	p_script->cached_bytecode.clear();
+
+	// Entries found by `make_scripts()` were validated already.
+	const bool validated = !data.is_empty();
+	if (!validated) {
+		const String path = p_script->get_script_path();
+		if (path.is_empty() || path.contains("::")) {
+			return ERR_UNAVAILABLE;
+		}
+		const String cache_file = _get_cache_file(path);
+		if (!FileAccess::exists(cache_file)) {
+			return ERR_FILE_NOT_FOUND;
+		}
+		Error err = OK;
+		data = FileAccess::get_file_as_bytes(cache_file, &err);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	return deserialize(p_script, data, !validated);
+}
+
+Error GDScriptBytecodeCache::save_script(const GDScript *p_script) {
+	const String path = p_script->get_script_path();
+	if (path.is_empty() || path.contains("::")) {
+		return ERR_UNAVAILABLE;
+	}
+
+	const Vector<uint8_t> data = serialize(p_script, GDScriptCache::get_parser_dependencies(path));
+	if (data.is_empty()) {
+		print_verbose(vformat("GDScript: Can't store the bytecode of \"%s\" in the cache, it will be compiled on every run.", path));
+		return ERR_UNAVAILABLE;
+	}
+
+	const String cache_file = _get_cache_file(path);
+	Error err = DirAccess::make_dir_recursive_absolute(cache_file.get_base_dir());
+	if (err != OK) {
+		return err;
+	}
+
+	// Write to a temporary file first, so other processes never read a partial entry.
+	const String temp_file = cache_file + ".tmp";
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_file, FileAccess::WRITE, &err);
+		if (file.is_null()) {
+			return err;
+		}
+		file->store_buffer(data.ptr(), data.size());
+	}
+	if (FileAccess::exists(cache_file)) {
+		DirAccess::remove_absolute(cache_file);
+	}
+	return DirAccess::rename_absolute(temp_file, cache_file);
+}
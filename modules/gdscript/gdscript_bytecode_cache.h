@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+// Stores compiled scripts on disk so later runs can skip parsing, analysis and
+// compilation. Function pointers, method binds and object constants are written
+// symbolically and resolved again on load. A cache entry is only used when it was
+// written by the same engine build for the same global map, and when neither the
+// script nor any script its analysis depended on changed since. Loaded code is
+// checked before use, any entry that fails is ignored and the script recompiled.
+class GDScriptBytecodeCache {
+	struct Writer;
+	struct Reader;
+	struct CodeValidator;
+
+	static Mutex mutex;
+	static String build_key;
+	static uint32_t globals_hash;
+	static int globals_hash_count;
+	static HashMap<String, String> file_hashes;
+
+	static String _get_file_hash(const String &p_path);
+	static String _get_cache_file(const String &p_path);
+
+	static bool _write_script_ref(Writer &p_writer, const Script *p_script, const GDScript *p_root);
+	static bool _write_constant(Writer &p_writer, const Variant &p_value, const GDScript *p_root);
+	static bool _write_data_type(Writer &p_writer, const GDScriptDataType &p_type, const GDScript *p_root);
+	static bool _write_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static bool _write_method_info(Writer &p_writer, const MethodInfo &p_info, const GDScript *p_root);
+	static bool _write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info, const GDScript *p_root);
+	static bool _write_function(Writer &p_writer, const GDScriptFunction *p_function, const GDScript *p_root);
+	static void _write_skeleton(Writer &p_writer, const GDScript *p_script);
+	static bool _write_class(Writer &p_writer, const GDScript *p_script, const GDScript *p_root);
+
+	static Ref<Script> _read_script_ref(Reader &p_reader, GDScript *p_root, bool &r_local);
+	static Variant _read_constant(Reader &p_reader, GDScript *p_root);
+	static GDScriptDataType _read_data_type(Reader &p_reader, GDScript *p_root);
+	static PropertyInfo _read_property_info(Reader &p_reader);
+	static MethodInfo _read_method_info(Reader &p_reader, GDScript *p_root);
+	static GDScript::MemberInfo _read_member_info(Reader &p_reader, GDScript *p_root);
+	static GDScriptFunction *_read_function(Reader &p_reader, GDScript *p_script, GDScript *p_root);
+	static void _read_skeleton(Reader &p_reader, GDScript *p_script);
+	static bool _read_class(Reader &p_reader, GDScript *p_script, GDScript *p_root);
+	static bool _validate_function(GDScriptFunction *p_function);
+	static bool _validate_class(GDScript *p_script);
+
+	static uint32_t _get_globals_hash();
+
+	static bool _read_header(Reader &p_reader, bool p_check_sources, const String &p_path, bool &r_static_script);
+
+public:
+	enum {
+		FORMAT_VERSION = 3,
+	};
+
+	static bool is_enabled();
+	static String get_build_key();
+
+	// Serializes a successfully compiled script, including its inner classes.
+	// Returns an empty buffer when something in it can't be stored symbolically.
+	static Vector<uint8_t> serialize(const GDScript *p_script, const HashSet<String> &p_dependencies);
+	// Replaces the contents of `p_script` with the ones stored in `p_data`. Only
+	// validates dependencies and sources when `p_check_sources` is set.
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_data, bool p_check_sources);
+
+	// Creates the inner class scripts from the cache entry of `p_script`, if there is a valid one.
+	// The entry is kept in the script for `load_script()`.
+	static Error make_scripts(GDScript *p_script);
+	static Error load_script(GDScript *p_script);
+	static Error save_script(const GDScript *p_script);
+
+	static void clear();
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
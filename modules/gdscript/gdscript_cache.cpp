@@ -32,10 +32,13 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -75,16 +78,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.get_extension().to_lower() == "gdc") {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				result = GDScriptCache::_parse_script(get_parser(), path, ResourceLoader::path_remap(path), source_hash);
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -295,6 +289,141 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	return buffer;
 }
 
+Error GDScriptCache::_parse_script(GDScriptParser *p_parser, const String &p_path, const String &p_remapped_path, uint32_t &r_source_hash) {
+	if (p_remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> tokens = get_binary_tokens(p_remapped_path);
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	}
+	String source = get_source_code(p_remapped_path);
+	r_source_hash = source.hash();
+	return p_parser->parse(source, p_path, false);
+}
+
+static void _add_script_dependency(const String &p_path, const String &p_base_dir, HashSet<String> &r_paths) {
+	const String extension = p_path.get_extension().to_lower();
+	if (extension != "gd" && extension != "gdc") {
+		return;
+	}
+	r_paths.insert(p_path.is_relative_path() ? p_base_dir.path_join(p_path).simplify_path() : p_path);
+}
+
+static void _add_preload_dependency(const GDScriptParser::ExpressionNode *p_expression, const String &p_base_dir, HashSet<String> &r_paths) {
+	if (p_expression == nullptr || p_expression->type != GDScriptParser::Node::PRELOAD) {
+		return;
+	}
+	const GDScriptParser::ExpressionNode *path = static_cast<const GDScriptParser::PreloadNode *>(p_expression)->path;
+	if (path != nullptr && path->type == GDScriptParser::Node::LITERAL) {
+		const Variant &value = static_cast<const GDScriptParser::LiteralNode *>(path)->value;
+		if (value.get_type() == Variant::STRING) {
+			_add_script_dependency(value, p_base_dir, r_paths);
+		}
+	}
+}
+
+// Scripts the analyzer will have to parse to resolve the interface of this class: its base and the scripts
+// preloaded by member initializers. Only what can be found without analyzing, the rest is parsed on demand.
+static void _collect_script_dependencies(const GDScriptParser::ClassNode *p_class, const String &p_base_dir, HashSet<String> &r_paths) {
+	if (!p_class->extends_path.is_empty()) {
+		_add_script_dependency(p_class->extends_path, p_base_dir, r_paths);
+	} else if (!p_class->extends.is_empty() && ScriptServer::is_global_class(p_class->extends[0]->name)) {
+		_add_script_dependency(ScriptServer::get_global_class_path(p_class->extends[0]->name), p_base_dir, r_paths);
+	}
+
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		switch (member.type) {
+			case GDScriptParser::ClassNode::Member::CLASS:
+				_collect_script_dependencies(member.m_class, p_base_dir, r_paths);
+				break;
+			case GDScriptParser::ClassNode::Member::CONSTANT:
+				_add_preload_dependency(member.constant->initializer, p_base_dir, r_paths);
+				break;
+			case GDScriptParser::ClassNode::Member::VARIABLE:
+				_add_preload_dependency(member.variable->initializer, p_base_dir, r_paths);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void GDScriptCache::_parse_script_task(uint32_t p_index, ParseTask *p_tasks) {
+	ParseTask &task = p_tasks[p_index];
+	task.result = _parse_script(task.parser, task.path, task.remapped_path, task.source_hash);
+}
+
+Vector<Ref<GDScriptParserRef>> GDScriptCache::parse_dependencies(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+
+	Vector<Ref<GDScriptParserRef>> parsed;
+	HashSet<String> visited;
+	visited.insert(p_path);
+	Vector<String> wave;
+	wave.push_back(p_path);
+
+	// Parse one level of the dependency graph at a time, each level discovers the next one.
+	while (!wave.is_empty()) {
+		LocalVector<ParseTask> tasks;
+		for (const String &path : wave) {
+			if (singleton->parser_map.has(path)) {
+				continue;
+			}
+			const String remapped_path = ResourceLoader::path_remap(path);
+			if (!FileAccess::exists(remapped_path)) {
+				continue; // Reported by the analyzer.
+			}
+			ParseTask task;
+			task.path = path;
+			task.remapped_path = remapped_path;
+			// Parsers are created on this thread, the first one registers the annotations.
+			task.parser = memnew(GDScriptParser);
+			tasks.push_back(task);
+		}
+
+		if (tasks.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(singleton, &GDScriptCache::_parse_script_task, tasks.ptr(), tasks.size(), -1, true, SNAME("GDScriptParse"));
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		} else if (tasks.size() == 1) {
+			singleton->_parse_script_task(0, tasks.ptr());
+		}
+
+		// Registering the parsers is the only step that needs the lock.
+		HashSet<String> dependencies;
+		for (ParseTask &task : tasks) {
+			if (singleton->cleared || singleton->parser_map.has(task.path)) {
+				// Parsed by another thread while the lock was lifted.
+				memdelete(task.parser);
+				continue;
+			}
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->path = task.path;
+			ref->parser = task.parser;
+			ref->status = GDScriptParserRef::PARSED;
+			ref->result = task.result;
+			ref->source_hash = task.source_hash;
+			singleton->parser_map[task.path] = ref.ptr();
+			parsed.push_back(ref);
+
+			if (task.result == OK) {
+				_collect_script_dependencies(task.parser->get_tree(), task.path.get_base_dir(), dependencies);
+			}
+		}
+
+		wave.clear();
+		for (const String &dependency : dependencies) {
+			if (!visited.has(dependency)) {
+				visited.insert(dependency);
+				wave.push_back(dependency);
+			}
+		}
+	}
+
+	return parsed;
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -327,9 +456,12 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// A valid bytecode cache entry already describes the inner classes, so there's no need to parse.
+	if (!GDScriptBytecodeCache::is_enabled() || GDScriptBytecodeCache::make_scripts(script.ptr()) != OK) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -353,7 +485,14 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Keeps the parsers of the dependencies alive until the analyzer picks them up.
+	Vector<Ref<GDScriptParserRef>> parsed_dependencies;
 	if (script.is_null()) {
+		// Cold load: parse the script and whatever it extends or preloads in parallel, so that only the analysis
+		// and compilation are serialized. A bytecode cache hit doesn't need any parser.
+		if (!singleton->parser_map.has(p_path) && !singleton->shallow_gdscript_cache.has(p_path) && !GDScriptBytecodeCache::is_enabled()) {
+			parsed_dependencies = parse_dependencies(p_path);
+		}
 		script = get_shallow_script(p_path, r_error);
 		// Only exit early if script failed to load, otherwise let reload report errors.
 		if (script.is_null()) {
@@ -445,6 +584,41 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+bool GDScriptCache::has_static_script(const String &p_fqcn) {
+	MutexLock lock(singleton->mutex);
+	return singleton->static_gdscript_cache.has(p_fqcn);
+}
+
+HashSet<String> GDScriptCache::get_parser_dependencies(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+
+	HashMap<String, HashSet<String>> parser_dependencies;
+	for (const KeyValue<String, HashSet<String>> &E : singleton->parser_inverse_dependencies) {
+		for (const String &owner : E.value) {
+			parser_dependencies[owner].insert(E.key);
+		}
+	}
+
+	// Everything the analysis of the script looked at, directly or through other scripts.
+	HashSet<String> result;
+	List<String> pending;
+	pending.push_back(p_path);
+	while (!pending.is_empty()) {
+		HashMap<String, HashSet<String>>::Iterator E = parser_dependencies.find(pending.front()->get());
+		pending.pop_front();
+		if (!E) {
+			continue;
+		}
+		for (const String &dependency : E->value) {
+			if (dependency != p_path && !result.has(dependency)) {
+				result.insert(dependency);
+				pending.push_back(dependency);
+			}
+		}
+	}
+	return result;
+}
+
 void GDScriptCache::clear() {
 	if (singleton == nullptr) {
 		return;
@@ -102,11 +102,23 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	struct ParseTask {
+		String path;
+		String remapped_path;
+		GDScriptParser *parser = nullptr;
+		Error result = OK;
+		uint32_t source_hash = 0;
+	};
+
+	static Error _parse_script(GDScriptParser *p_parser, const String &p_path, const String &p_remapped_path, uint32_t &r_source_hash);
+	void _parse_script_task(uint32_t p_index, ParseTask *p_tasks);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static bool has_parser(const String &p_path);
+	static Vector<Ref<GDScriptParserRef>> parse_dependencies(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
 	static Vector<uint8_t> get_binary_tokens(const String &p_path);
@@ -116,6 +128,8 @@ public:
 	static Error finish_compiling(const String &p_owner);
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
+	static bool has_static_script(const String &p_fqcn);
+	static HashSet<String> get_parser_dependencies(const String &p_path);
 
 	static void clear();
 
@@ -37,6 +37,7 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
 
 #include "scene/scene_string_names.h"
 
@@ -252,6 +253,129 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+// Expressions that can be compiled in place of a call: no side effects on the parameters and nothing that depends on
+// the function they come from (locals, members, `self`, other script calls).
+bool GDScriptCompiler::_is_inlinable_expression(const GDScriptParser::ExpressionNode *p_expression, int &r_budget) {
+	if (p_expression == nullptr || --r_budget < 0) {
+		return false;
+	}
+	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
+		return true;
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER:
+			return static_cast<const GDScriptParser::IdentifierNode *>(p_expression)->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER;
+		case GDScriptParser::Node::UNARY_OPERATOR:
+			return _is_inlinable_expression(static_cast<const GDScriptParser::UnaryOpNode *>(p_expression)->operand, r_budget);
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			return _is_inlinable_expression(binary->left_operand, r_budget) && _is_inlinable_expression(binary->right_operand, r_budget);
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			return _is_inlinable_expression(ternary->condition, r_budget) && _is_inlinable_expression(ternary->true_expr, r_budget) && _is_inlinable_expression(ternary->false_expr, r_budget);
+		}
+		case GDScriptParser::Node::SUBSCRIPT: {
+			const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_expression);
+			const GDScriptParser::DataType base_type = subscript->base ? subscript->base->get_datatype() : GDScriptParser::DataType();
+			if (!base_type.is_hard_type() || base_type.kind != GDScriptParser::DataType::BUILTIN) {
+				return false;
+			}
+			return _is_inlinable_expression(subscript->base, r_budget) && (subscript->is_attribute || _is_inlinable_expression(subscript->index, r_budget));
+		}
+		case GDScriptParser::Node::CALL: {
+			const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(p_expression);
+			if (call->is_super || call->callee == nullptr || call->callee->type != GDScriptParser::Node::IDENTIFIER) {
+				return false;
+			}
+			if (GDScriptParser::get_builtin_type(call->function_name) >= Variant::VARIANT_MAX && !Variant::has_utility_function(call->function_name)) {
+				return false;
+			}
+			for (const GDScriptParser::ExpressionNode *argument : call->arguments) {
+				if (!_is_inlinable_expression(argument, r_budget)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+// Calls to small static functions of the class being compiled are replaced by the expression they return. Those calls
+// are dispatched on the class itself, so no other function can be reached through them.
+const GDScriptParser::FunctionNode *GDScriptCompiler::_get_inline_function(CodeGen &codegen, const GDScriptParser::CallNode *p_call) const {
+	static const int MAX_INLINE_EXPRESSION_SIZE = 24; // In parse tree nodes.
+
+	if (!optimize || p_call->is_super || !p_call->is_static || p_call->callee == nullptr || p_call->callee->type != GDScriptParser::Node::IDENTIFIER) {
+		return nullptr;
+	}
+	if (codegen.class_node == nullptr || !codegen.class_node->has_function(p_call->function_name) || ClassDB::has_method(codegen.script->native->get_name(), p_call->function_name)) {
+		return nullptr;
+	}
+
+	const GDScriptParser::FunctionNode *function = codegen.class_node->get_member(p_call->function_name).function;
+	if (!function->is_static || function->is_coroutine || function == codegen.function_node || function->parameters.size() != p_call->arguments.size()) {
+		return nullptr;
+	}
+	if (function->body == nullptr || function->body->statements.size() != 1 || function->body->statements[0]->type != GDScriptParser::Node::RETURN) {
+		return nullptr;
+	}
+
+	// Arguments and the return value must not need a conversion, which the call would do.
+	for (int i = 0; i < function->parameters.size(); i++) {
+		const GDScriptParser::DataType parameter_type = function->parameters[i]->get_datatype();
+		const GDScriptParser::DataType argument_type = p_call->arguments[i]->get_datatype();
+		if (!parameter_type.is_hard_type() || parameter_type.kind != GDScriptParser::DataType::BUILTIN || parameter_type.has_container_element_types()) {
+			return nullptr;
+		}
+		if (!argument_type.is_hard_type() || argument_type.kind != GDScriptParser::DataType::BUILTIN || argument_type.builtin_type != parameter_type.builtin_type) {
+			return nullptr;
+		}
+	}
+
+	const GDScriptParser::ExpressionNode *return_value = static_cast<const GDScriptParser::ReturnNode *>(function->body->statements[0])->return_value;
+	if (return_value == nullptr) {
+		return nullptr;
+	}
+	const GDScriptParser::DataType return_type = p_call->get_datatype();
+	const GDScriptParser::DataType value_type = return_value->get_datatype();
+	if (!return_type.is_hard_type() || return_type.kind != GDScriptParser::DataType::BUILTIN || return_type.has_container_element_types()) {
+		return nullptr;
+	}
+	if (!value_type.is_hard_type() || value_type.kind != GDScriptParser::DataType::BUILTIN || value_type.builtin_type != return_type.builtin_type) {
+		return nullptr;
+	}
+
+	int budget = MAX_INLINE_EXPRESSION_SIZE;
+	return _is_inlinable_expression(return_value, budget) ? function : nullptr;
+}
+
+// Locals which start from a constant and are never assigned again are compiled as local constants.
+bool GDScriptCompiler::_is_propagated_local(const GDScriptParser::VariableNode *p_variable) const {
+	if (!optimize || p_variable == nullptr || p_variable->modified || p_variable->initializer == nullptr || !p_variable->initializer->is_constant) {
+		return false;
+	}
+
+	// Only immutable values, anything else could be modified through a method call.
+	const Variant &value = p_variable->initializer->reduced_value;
+	switch (value.get_type()) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+			break;
+		default:
+			return false;
+	}
+
+	const GDScriptParser::DataType variable_type = p_variable->get_datatype();
+	return !variable_type.is_hard_type() || (variable_type.kind == GDScriptParser::DataType::BUILTIN && variable_type.builtin_type == value.get_type());
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -266,6 +390,13 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 
 			StringName identifier = in->name;
 
+			if (in->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER && !codegen.inline_arguments.is_empty()) {
+				HashMap<const GDScriptParser::ParameterNode *, GDScriptCodeGenerator::Address>::ConstIterator E = codegen.inline_arguments.find(in->parameter_source);
+				if (E) {
+					return E->value;
+				}
+			}
+
 			switch (in->source) {
 				// LOCALS.
 				case GDScriptParser::IdentifierNode::FUNCTION_PARAMETER:
@@ -620,7 +751,25 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 				arguments.push_back(arg);
 			}
 
-			if (!call->is_super && call->callee->type == GDScriptParser::Node::IDENTIFIER && GDScriptParser::get_builtin_type(call->function_name) < Variant::VARIANT_MAX) {
+			const GDScriptParser::FunctionNode *inline_function = is_awaited ? nullptr : _get_inline_function(codegen, call);
+			if (inline_function) {
+				// Compile the returned expression with the parameters bound to the arguments.
+				for (int i = 0; i < arguments.size(); i++) {
+					codegen.inline_arguments[inline_function->parameters[i]] = arguments[i];
+				}
+				const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(inline_function->body->statements[0]);
+				GDScriptCodeGenerator::Address value = _parse_expression(codegen, r_error, return_node->return_value);
+				codegen.inline_arguments.clear();
+				if (r_error) {
+					return GDScriptCodeGenerator::Address();
+				}
+				if (result.mode != GDScriptCodeGenerator::Address::NIL) {
+					gen->write_assign(result, value);
+				}
+				if (value.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+					gen->pop_temporary();
+				}
+			} else if (!call->is_super && call->callee->type == GDScriptParser::Node::IDENTIFIER && GDScriptParser::get_builtin_type(call->function_name) < Variant::VARIANT_MAX) {
 				gen->write_construct(result, GDScriptParser::get_builtin_type(call->function_name), arguments);
 			} else if (!call->is_super && call->callee->type == GDScriptParser::Node::IDENTIFIER && Variant::has_utility_function(call->function_name)) {
 				// Variant utility function.
@@ -1875,6 +2024,10 @@ List<GDScriptCodeGenerator::Address> GDScriptCompiler::_add_block_locals(CodeGen
 			// Parameters are added directly from function and loop variables are declared explicitly.
 			continue;
 		}
+		if (p_block->locals[i].type == GDScriptParser::SuiteNode::Local::VARIABLE && _is_propagated_local(p_block->locals[i].variable)) {
+			// Becomes a local constant at its declaration, no stack slot needed.
+			continue;
+		}
 		addresses.push_back(codegen.add_local(p_block->locals[i].name, _gdtype_from_datatype(p_block->locals[i].get_datatype(), codegen.script)));
 	}
 	return addresses;
@@ -1907,6 +2060,8 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 #ifdef DEBUG_ENABLED
 		// Add a newline before each statement, since the debugger needs those.
 		gen->write_newline(s->start_line);
+#else
+		gen->set_line(s->start_line);
 #endif
 
 		switch (s->type) {
@@ -1959,6 +2114,8 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 #ifdef DEBUG_ENABLED
 					// Add a newline before each branch, since the debugger needs those.
 					gen->write_newline(branch->start_line);
+#else
+					gen->set_line(branch->start_line);
 #endif
 					// For each pattern in branch.
 					GDScriptCodeGenerator::Address pattern_result = codegen.add_temporary();
@@ -2178,6 +2335,11 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::VARIABLE: {
 				const GDScriptParser::VariableNode *lv = static_cast<const GDScriptParser::VariableNode *>(s);
+				if (_is_propagated_local(lv)) {
+					// Never modified, so the initializer store is dead and reads can use the constant.
+					codegen.add_local_constant(lv->identifier->name, lv->initializer->reduced_value);
+					break;
+				}
 				// Should be already in stack when the block began.
 				GDScriptCodeGenerator::Address local = codegen.locals[lv->identifier->name];
 				GDScriptDataType local_type = _gdtype_from_datatype(lv->get_datatype(), codegen.script);
@@ -2696,6 +2858,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	p_script->member_functions.clear();
 	p_script->member_indices.clear();
+	GDScriptFunction::invalidate_inline_caches();
 	p_script->static_variables_indices.clear();
 	p_script->static_variables.clear();
 	p_script->_signals.clear();
@@ -3252,12 +3415,24 @@ void GDScriptCompiler::_get_function_ptr_replacements(HashMap<GDScriptFunction *
 	}
 }
 
+// Inlined calls and propagated locals can't be seen in the debugger, so a debugged
+// game runs the code as written.
+bool GDScriptCompiler::is_optimizing() {
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_active()) {
+		return false;
+	}
+#endif
+	return GLOBAL_GET("gdscript/compiler/optimize");
+}
+
 Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state) {
 	err_line = -1;
 	err_column = -1;
 	error = "";
 	parser = p_parser;
 	main_script = p_script;
+	optimize = is_optimizing();
 	const GDScriptParser::ClassNode *root = parser->get_tree();
 
 	source = p_script->get_path();
@@ -32,6 +32,68 @@
 
 #include "gdscript.h"
 
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_epoch;
+BinaryMutex GDScriptFunction::inline_cache_mutex;
+
+SpinLock GDScriptCoroutineFramePool::spin_lock;
+GDScriptCoroutineFramePool::FreeFrame *GDScriptCoroutineFramePool::free_frames[SIZE_CLASS_COUNT] = {};
+uint32_t GDScriptCoroutineFramePool::free_frame_count[SIZE_CLASS_COUNT] = {};
+SafeNumeric<uint64_t> GDScriptCoroutineFramePool::allocated_bytes;
+
+uint8_t *GDScriptCoroutineFramePool::allocate(uint32_t p_size, uint32_t &r_capacity) {
+	r_capacity = next_power_of_2(MAX(p_size, uint32_t(1) << MIN_SIZE_CLASS));
+	const uint32_t size_class = get_shift_from_power_of_2(r_capacity) - MIN_SIZE_CLASS;
+
+	if (size_class < SIZE_CLASS_COUNT) {
+		spin_lock.lock();
+		FreeFrame *frame = free_frames[size_class];
+		if (frame) {
+			free_frames[size_class] = frame->next;
+			free_frame_count[size_class]--;
+		}
+		spin_lock.unlock();
+		if (frame) {
+			return (uint8_t *)frame;
+		}
+	}
+
+	allocated_bytes.add(r_capacity);
+	return (uint8_t *)Memory::alloc_static(r_capacity);
+}
+
+void GDScriptCoroutineFramePool::release(uint8_t *p_frame, uint32_t p_capacity) {
+	const uint32_t size_class = get_shift_from_power_of_2(p_capacity) - MIN_SIZE_CLASS;
+
+	if (size_class < SIZE_CLASS_COUNT) {
+		spin_lock.lock();
+		if (free_frame_count[size_class] < MAX_FREE_FRAMES) {
+			FreeFrame *frame = memnew_placement(p_frame, FreeFrame);
+			frame->next = free_frames[size_class];
+			free_frames[size_class] = frame;
+			free_frame_count[size_class]++;
+			p_frame = nullptr;
+		}
+		spin_lock.unlock();
+	}
+
+	if (p_frame) {
+		Memory::free_static(p_frame);
+	}
+}
+
+void GDScriptCoroutineFramePool::clear() {
+	spin_lock.lock();
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		while (free_frames[i]) {
+			FreeFrame *frame = free_frames[i];
+			free_frames[i] = frame->next;
+			Memory::free_static(frame);
+		}
+		free_frame_count[i] = 0;
+	}
+	spin_lock.unlock();
+}
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -42,6 +104,21 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+int GDScriptFunction::get_line_at(int p_ip) const {
+	// Last mapping starting at or before the instruction.
+	int low = 0;
+	int high = line_mappings.size();
+	while (low < high) {
+		const int middle = (low + high) / 2;
+		if (line_mappings[middle].ip <= p_ip) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low > 0 ? line_mappings[low - 1].line : _initial_line;
+}
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -116,6 +193,12 @@ GDScriptFunction::GDScriptFunction() {
 
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
+	// Cache entries in other functions may point to this one.
+	invalidate_inline_caches();
+
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
@@ -241,9 +324,9 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		}
+#endif
 
 		_clear_stack();
-#endif
 	}
 
 	return ret;
@@ -251,13 +334,18 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
 		}
 		state.stack_size = 0;
 	}
+	if (state.stack) {
+		GDScriptCoroutineFramePool::release(state.stack, state.stack_capacity);
+		state.stack = nullptr;
+		state.stack_capacity = 0;
+	}
 }
 
 void GDScriptFunctionState::_clear_connections() {
@@ -288,4 +376,6 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	// Never resumed, e.g. the awaited object was freed.
+	_clear_stack();
 }
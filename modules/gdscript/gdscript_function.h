@@ -35,15 +35,44 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
 class GDScriptInstance;
 class GDScript;
 
+// Recycles the stack buffers of suspended calls, so code awaiting every frame doesn't go through the
+// allocator each time. Buffers are grouped in power-of-two size classes and can be released from any thread.
+class GDScriptCoroutineFramePool {
+	enum {
+		MIN_SIZE_CLASS = 6, // 64 bytes.
+		SIZE_CLASS_COUNT = 14, // Up to 512 KiB, bigger frames aren't pooled.
+		MAX_FREE_FRAMES = 256, // Per size class.
+	};
+
+	struct FreeFrame {
+		FreeFrame *next = nullptr;
+	};
+
+	static SpinLock spin_lock;
+	static FreeFrame *free_frames[SIZE_CLASS_COUNT];
+	static uint32_t free_frame_count[SIZE_CLASS_COUNT];
+	static SafeNumeric<uint64_t> allocated_bytes;
+
+public:
+	static uint8_t *allocate(uint32_t p_size, uint32_t &r_capacity);
+	static void release(uint8_t *p_frame, uint32_t p_capacity);
+	// Total bytes requested from the allocator, frames served from the pool don't count.
+	static uint64_t get_allocated_bytes() { return allocated_bytes.get(); }
+	static void clear();
+};
+
 class GDScriptDataType {
 public:
 	Vector<GDScriptDataType> container_element_types;
@@ -257,6 +286,9 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -442,6 +474,7 @@ public:
 
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
@@ -465,6 +498,14 @@ private:
 	HashMap<int, Variant::Type> temporary_slots;
 	List<StackDebug> stack_debug;
 
+	// Source line of each statement, sorted by instruction pointer. Unlike the
+	// line opcodes this is kept in release builds, for the sampling profiler.
+	struct LineMapping {
+		int ip = 0;
+		int line = 0;
+	};
+	Vector<LineMapping> line_mappings;
+
 	Vector<int> code;
 	Vector<int> default_arguments;
 	Vector<Variant> constants;
@@ -519,6 +560,56 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Untyped calls and named property accesses remember how the name was resolved
+	// for the last receiver seen at each call site, to skip the lookups when the
+	// next receiver has the same class and script.
+	struct InlineCacheEntry {
+		enum Kind {
+			KIND_SCRIPT_FUNCTION, // Function of the receiver's script.
+			KIND_METHOD_BIND, // Native method.
+			KIND_SCRIPT_MEMBER, // Script member variable without setter or getter.
+			KIND_NATIVE_PROPERTY, // Native property with a non-indexed setter or getter.
+		};
+
+		Kind kind = KIND_METHOD_BIND;
+		uint32_t epoch = 0;
+		const GDScript *script = nullptr; // Script of the receiver, `nullptr` if it has none.
+		const void *native_class = nullptr; // Unique pointer of the receiver's class name, entries are copied without locking.
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+		int member_index = -1;
+		const GDScriptDataType *member_type = nullptr;
+	};
+
+	struct InlineCache {
+		// A site that keeps missing is megamorphic, stop caching once all entries are used.
+		// Only misses within the same epoch count, a site with stale entries starts over.
+		static constexpr uint32_t MAX_ENTRIES = 4;
+
+		// Entries are only written under `inline_cache_mutex`, with `sequence` odd meanwhile.
+		// Readers copy the entry in use and drop the copy if `sequence` changed.
+		SafeNumeric<uint32_t> sequence;
+		SafeNumeric<uint32_t> epoch; // Epoch the entries were added in.
+		SafeNumeric<uint32_t> used;
+		uint32_t active = 0; // One-based index of the entry in use, zero when empty.
+		InlineCacheEntry entries[MAX_ENTRIES];
+	};
+
+	// Bumped whenever script functions or members change, which invalidates all cache entries.
+	static SafeNumeric<uint32_t> inline_cache_epoch;
+	static BinaryMutex inline_cache_mutex;
+
+	InlineCache *_inline_caches_ptr = nullptr;
+	int _inline_caches_count = 0;
+
+	static bool _get_inline_cache_receiver(const Object *p_object, const GDScript *&r_script);
+	static const InlineCacheEntry *_get_inline_cache_entry(const InlineCache &p_cache, const Object *p_object, InlineCacheEntry &r_entry);
+	static const InlineCacheEntry *_add_inline_cache_entry(InlineCache &p_cache, const InlineCacheEntry &p_entry);
+	static bool _resolve_inline_call(const Object *p_object, const StringName &p_method, InlineCacheEntry &r_entry);
+	static bool _resolve_inline_get(const Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry);
+	static bool _resolve_inline_set(const Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry);
+	static void _call_inline_cached(const InlineCacheEntry *p_entry, Object *p_object, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -565,7 +656,8 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // From GDScriptCoroutineFramePool.
+		uint32_t stack_capacity = 0;
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -582,11 +674,13 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	int get_line_at(int p_ip) const;
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
 
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
+	static void invalidate_inline_caches() { inline_cache_epoch.increment(); }
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 #ifdef DEBUG_ENABLED
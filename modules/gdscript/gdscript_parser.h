@@ -1265,6 +1265,7 @@ public:
 		bool onready = false;
 		PropertyInfo export_info;
 		int assignments = 0;
+		bool modified = false; // For locals: assigned after the declaration, directly or through a subscript.
 		bool is_static = false;
 #ifdef TOOLS_ENABLED
 		MemberDocData doc_data;
@@ -0,0 +1,231 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript_function.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+GDScriptSamplingProfiler *GDScriptSamplingProfiler::singleton = nullptr;
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::sample_epoch;
+Mutex GDScriptSamplingProfiler::mutex;
+
+GDScriptSamplingProfiler::ThreadStack::~ThreadStack() {
+	MutexLock lock(mutex);
+	if (!registered || !singleton) {
+		return;
+	}
+
+	// Keep the samples of the thread around, it may have been a short-lived worker.
+	singleton->thread_stacks.erase(this);
+	for (const KeyValue<String, uint64_t> &E : samples) {
+		singleton->retired_samples[E.key] += E.value;
+	}
+}
+
+void GDScriptSamplingProfiler::_timer_thread_func(void *p_userdata) {
+	GDScriptSamplingProfiler *profiler = static_cast<GDScriptSamplingProfiler *>(p_userdata);
+	while (active.is_set()) {
+		OS::get_singleton()->delay_usec(profiler->interval_usec);
+		sample_epoch.increment();
+	}
+}
+
+GDScriptSamplingProfiler::ThreadStack *GDScriptSamplingProfiler::_get_thread_stack() {
+	static thread_local ThreadStack thread_stack;
+	if (unlikely(!thread_stack.registered)) {
+		MutexLock lock(mutex);
+		if (singleton) {
+			singleton->thread_stacks.push_back(&thread_stack);
+			thread_stack.registered = true;
+		}
+	}
+	return &thread_stack;
+}
+
+String GDScriptSamplingProfiler::_get_frame_name(const GDScriptFunction *p_function, int p_ip) {
+	String source = p_function->get_source();
+	if (source.is_empty()) {
+		source = "<built-in>";
+	}
+	if (p_ip >= 0) {
+		source += ":" + itos(p_function->get_line_at(p_ip));
+	}
+	return String(p_function->get_name()) + " (" + source + ")";
+}
+
+void GDScriptSamplingProfiler::_record_sample(ThreadStack *p_stack, int p_ip, uint32_t p_epoch) {
+	// A thread which was blocked for several ticks gets all of them at once.
+	const uint32_t weight = p_epoch - p_stack->epoch;
+	p_stack->epoch = p_epoch;
+
+	String stack;
+	const uint32_t depth = p_stack->functions.size();
+	for (uint32_t i = 0; i < depth; i++) {
+		if (i > 0) {
+			stack += ";";
+		}
+		// Only the innermost frame knows where it is, the others are somewhere in a call.
+		stack += _get_frame_name(p_stack->functions[i], i == depth - 1 ? p_ip : -1);
+	}
+
+	MutexLock lock(p_stack->mutex);
+	p_stack->samples[stack] += weight;
+}
+
+GDScriptSamplingProfiler::ThreadStack *GDScriptSamplingProfiler::enter_function(const GDScriptFunction *p_function, int p_ip) {
+	ThreadStack *stack = _get_thread_stack();
+	if (stack->functions.is_empty()) {
+		// Time spent outside of scripts doesn't count.
+		stack->epoch = sample_epoch.get();
+	}
+	stack->functions.push_back(p_function);
+	poll(stack, p_ip);
+	return stack;
+}
+
+void GDScriptSamplingProfiler::exit_function(ThreadStack *p_stack) {
+	if (!p_stack->functions.is_empty()) {
+		p_stack->functions.resize(p_stack->functions.size() - 1);
+	}
+}
+
+HashMap<String, uint64_t> GDScriptSamplingProfiler::_get_samples() const {
+	MutexLock lock(mutex);
+	HashMap<String, uint64_t> samples = retired_samples;
+	for (ThreadStack *thread_stack : thread_stacks) {
+		MutexLock stack_lock(thread_stack->mutex);
+		for (const KeyValue<String, uint64_t> &E : thread_stack->samples) {
+			samples[E.key] += E.value;
+		}
+	}
+	return samples;
+}
+
+Error GDScriptSamplingProfiler::start(int p_interval_usec) {
+	ERR_FAIL_COND_V_MSG(active.is_set(), ERR_ALREADY_IN_USE, "The sampling profiler is already running.");
+	ERR_FAIL_COND_V(p_interval_usec < 0, ERR_INVALID_PARAMETER);
+
+	interval_usec = p_interval_usec;
+	active.set();
+	if (interval_usec > 0) {
+		timer_thread.start(_timer_thread_func, this);
+	}
+	return OK;
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+	active.clear();
+	if (timer_thread.is_started()) {
+		timer_thread.wait_to_finish();
+	}
+}
+
+bool GDScriptSamplingProfiler::is_running() const {
+	return active.is_set();
+}
+
+void GDScriptSamplingProfiler::request_sample() {
+	sample_epoch.increment();
+}
+
+int64_t GDScriptSamplingProfiler::get_sample_count() const {
+	int64_t count = 0;
+	for (const KeyValue<String, uint64_t> &E : _get_samples()) {
+		count += E.value;
+	}
+	return count;
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() const {
+	const HashMap<String, uint64_t> samples = _get_samples();
+
+	Vector<String> stacks;
+	for (const KeyValue<String, uint64_t> &E : samples) {
+		stacks.push_back(E.key);
+	}
+	stacks.sort();
+
+	String result;
+	for (const String &stack : stacks) {
+		result += stack + " " + itos(samples[stack]) + "\n";
+	}
+	return result;
+}
+
+Error GDScriptSamplingProfiler::save_collapsed_stacks(const String &p_path) const {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Cannot open file '%s' to save the profiler samples.", p_path));
+
+	file->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	retired_samples.clear();
+	for (ThreadStack *thread_stack : thread_stacks) {
+		MutexLock stack_lock(thread_stack->mutex);
+		thread_stack->samples.clear();
+	}
+}
+
+void GDScriptSamplingProfiler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start", "interval_usec"), &GDScriptSamplingProfiler::start, DEFVAL(1000));
+	ClassDB::bind_method(D_METHOD("stop"), &GDScriptSamplingProfiler::stop);
+	ClassDB::bind_method(D_METHOD("is_running"), &GDScriptSamplingProfiler::is_running);
+	ClassDB::bind_static_method("GDScriptSamplingProfiler", D_METHOD("request_sample"), &GDScriptSamplingProfiler::request_sample);
+	ClassDB::bind_method(D_METHOD("get_sample_count"), &GDScriptSamplingProfiler::get_sample_count);
+	ClassDB::bind_method(D_METHOD("get_collapsed_stacks"), &GDScriptSamplingProfiler::get_collapsed_stacks);
+	ClassDB::bind_method(D_METHOD("save_collapsed_stacks", "path"), &GDScriptSamplingProfiler::save_collapsed_stacks);
+	ClassDB::bind_method(D_METHOD("clear"), &GDScriptSamplingProfiler::clear);
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler() {
+	MutexLock lock(mutex);
+	singleton = this;
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+
+	MutexLock lock(mutex);
+	for (ThreadStack *thread_stack : thread_stacks) {
+		thread_stack->registered = false;
+	}
+	singleton = nullptr;
+}
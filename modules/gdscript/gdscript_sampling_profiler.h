@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Statistical profiler that also works in release builds. A timer thread bumps
+// an epoch at a fixed interval, and each thread running scripts records where it
+// is the next time it reaches a safe point (function entry or a jump) after the
+// epoch changed. Samples are weighted by the ticks elapsed since the last one.
+class GDScriptSamplingProfiler : public Object {
+	GDCLASS(GDScriptSamplingProfiler, Object);
+
+public:
+	// Script functions running on a thread, pushed and popped by the VM while sampling.
+	struct ThreadStack {
+		LocalVector<const GDScriptFunction *> functions;
+		uint32_t epoch = 0; // Epoch of the last sample.
+		BinaryMutex mutex; // Guards the samples, which are read from other threads.
+		HashMap<String, uint64_t> samples; // Collapsed call stack to sample count.
+		bool registered = false;
+
+		~ThreadStack();
+	};
+
+private:
+	static GDScriptSamplingProfiler *singleton;
+
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> sample_epoch;
+
+	uint32_t interval_usec = 1000;
+	Thread timer_thread;
+
+	// Static, so exiting threads can still lock it to check whether the profiler is gone.
+	static Mutex mutex; // Guards the singleton, the registered thread stacks and the retired samples.
+	LocalVector<ThreadStack *> thread_stacks;
+	HashMap<String, uint64_t> retired_samples; // From threads which have exited.
+
+	static void _timer_thread_func(void *p_userdata);
+	static ThreadStack *_get_thread_stack();
+	static void _record_sample(ThreadStack *p_stack, int p_ip, uint32_t p_epoch);
+	static String _get_frame_name(const GDScriptFunction *p_function, int p_ip);
+
+	HashMap<String, uint64_t> _get_samples() const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	static GDScriptSamplingProfiler *get_singleton() { return singleton; }
+
+	_FORCE_INLINE_ static bool is_sampling() { return active.is_set(); }
+	static ThreadStack *enter_function(const GDScriptFunction *p_function, int p_ip);
+	static void exit_function(ThreadStack *p_stack);
+
+	// Safe point, records a sample if the timer ticked since the last one.
+	_FORCE_INLINE_ static void poll(ThreadStack *p_stack, int p_ip) {
+		const uint32_t epoch = sample_epoch.get();
+		if (unlikely(epoch != p_stack->epoch)) {
+			_record_sample(p_stack, p_ip, epoch);
+		}
+	}
+
+	Error start(int p_interval_usec = 1000);
+	void stop();
+	bool is_running() const;
+	static void request_sample();
+
+	int64_t get_sample_count() const;
+	String get_collapsed_stacks() const;
+	Error save_collapsed_stacks(const String &p_path) const;
+	void clear();
+
+	GDScriptSamplingProfiler();
+	~GDScriptSamplingProfiler();
+};
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
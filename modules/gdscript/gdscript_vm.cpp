@@ -31,8 +31,11 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
+#include "core/config/engine.h"
 #include "core/os/os.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -185,6 +188,205 @@ String GDScriptFunction::_get_call_error(const String &p_where, const Variant **
 	return "Bug: Invalid call error code " + itos(p_err.error) + ".";
 }
 
+bool GDScriptFunction::_get_inline_cache_receiver(const Object *p_object, const GDScript *&r_script) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance) {
+		r_script = nullptr;
+		return true;
+	}
+	if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+		return false;
+	}
+	r_script = static_cast<GDScriptInstance *>(script_instance)->script.ptr();
+	return true;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_get_inline_cache_entry(const InlineCache &p_cache, const Object *p_object, InlineCacheEntry &r_entry) {
+	const uint32_t sequence = p_cache.sequence.get();
+	if (sequence & 1) {
+		return nullptr; // Being written.
+	}
+	const uint32_t active = p_cache.active;
+	if (active == 0 || active > InlineCache::MAX_ENTRIES) {
+		return nullptr;
+	}
+	r_entry = p_cache.entries[active - 1];
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (p_cache.sequence.get() != sequence) {
+		return nullptr;
+	}
+
+	if (r_entry.epoch != inline_cache_epoch.get() || r_entry.native_class != p_object->get_class_name().data_unique_pointer()) {
+		return nullptr;
+	}
+	const GDScript *script = nullptr;
+	if (!_get_inline_cache_receiver(p_object, script) || script != r_entry.script) {
+		return nullptr;
+	}
+	return &r_entry;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_add_inline_cache_entry(InlineCache &p_cache, const InlineCacheEntry &p_entry) {
+	const uint32_t epoch = inline_cache_epoch.get();
+	if (p_cache.epoch.get() == epoch && p_cache.used.get() >= InlineCache::MAX_ENTRIES) {
+		return nullptr;
+	}
+
+	MutexLock lock(inline_cache_mutex);
+	if (p_cache.epoch.get() != epoch) {
+		// Entries from older epochs can't match anymore, reuse their slots.
+		p_cache.epoch.set(epoch);
+		p_cache.used.set(0);
+	}
+	const uint32_t slot = p_cache.used.get();
+	if (slot >= InlineCache::MAX_ENTRIES) {
+		return nullptr;
+	}
+	p_cache.sequence.increment();
+	p_cache.entries[slot] = p_entry;
+	p_cache.active = slot + 1;
+	p_cache.used.set(slot + 1);
+	p_cache.sequence.increment();
+	return &p_entry;
+}
+
+// The resolvers below mirror the lookup order of `Object::callp()`, `Object::get()` and
+// `Object::set()` (script instance first, then ClassDB), and refuse to cache anything
+// whose result may depend on state other than the receiver's class and script.
+
+bool GDScriptFunction::_resolve_inline_call(const Object *p_object, const StringName &p_method, InlineCacheEntry &r_entry) {
+	if (p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+		return false; // Handled specially by `Object::callp()` and `GDScriptInstance::callp()`.
+	}
+
+	const StringName &native_class = p_object->get_class_name();
+	r_entry.epoch = inline_cache_epoch.get();
+	r_entry.native_class = native_class.data_unique_pointer();
+	if (!_get_inline_cache_receiver(p_object, r_entry.script)) {
+		return false;
+	}
+
+	for (const GDScript *sptr = r_entry.script; sptr; sptr = sptr->_base) {
+		if (!sptr->valid) {
+			return false;
+		}
+		HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_method);
+		if (E) {
+			r_entry.kind = InlineCacheEntry::KIND_SCRIPT_FUNCTION;
+			r_entry.function = E->value;
+			return true;
+		}
+	}
+
+	r_entry.method = ClassDB::get_method(native_class, p_method);
+	if (!r_entry.method) {
+		return false;
+	}
+	r_entry.kind = InlineCacheEntry::KIND_METHOD_BIND;
+	return true;
+}
+
+bool GDScriptFunction::_resolve_inline_get(const Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry) {
+	const StringName &native_class = p_object->get_class_name();
+	r_entry.epoch = inline_cache_epoch.get();
+	r_entry.native_class = native_class.data_unique_pointer();
+	if (!_get_inline_cache_receiver(p_object, r_entry.script)) {
+		return false;
+	}
+
+	if (r_entry.script) {
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = r_entry.script->member_indices.find(p_name);
+		if (E) {
+			if (E->value.getter) {
+				return false;
+			}
+			r_entry.kind = InlineCacheEntry::KIND_SCRIPT_MEMBER;
+			r_entry.member_index = E->value.index;
+			return true;
+		}
+
+		for (const GDScript *sptr = r_entry.script; sptr; sptr = sptr->_base) {
+			if (!sptr->valid || sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._get)) {
+				return false;
+			}
+		}
+	}
+
+	ClassDB::APIType api = ClassDB::get_api_type(native_class);
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		return false; // Extensions may handle the property themselves.
+	}
+
+	bool is_property = false;
+	if (ClassDB::get_property_index(native_class, p_name, &is_property) != -1 || !is_property) {
+		return false;
+	}
+	r_entry.method = ClassDB::get_method(native_class, ClassDB::get_property_getter(native_class, p_name));
+	if (!r_entry.method) {
+		return false;
+	}
+	r_entry.kind = InlineCacheEntry::KIND_NATIVE_PROPERTY;
+	return true;
+}
+
+bool GDScriptFunction::_resolve_inline_set(const Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry) {
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false; // `Object::set()` also marks the object as edited.
+	}
+#endif
+
+	const StringName &native_class = p_object->get_class_name();
+	r_entry.epoch = inline_cache_epoch.get();
+	r_entry.native_class = native_class.data_unique_pointer();
+	if (!_get_inline_cache_receiver(p_object, r_entry.script)) {
+		return false;
+	}
+
+	if (r_entry.script) {
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = r_entry.script->member_indices.find(p_name);
+		if (E) {
+			if (E->value.setter) {
+				return false;
+			}
+			r_entry.kind = InlineCacheEntry::KIND_SCRIPT_MEMBER;
+			r_entry.member_index = E->value.index;
+			r_entry.member_type = &E->value.data_type;
+			return true;
+		}
+
+		for (const GDScript *sptr = r_entry.script; sptr; sptr = sptr->_base) {
+			if (!sptr->valid || sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._set)) {
+				return false;
+			}
+		}
+	}
+
+	ClassDB::APIType api = ClassDB::get_api_type(native_class);
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		return false; // Extensions may handle the property themselves.
+	}
+
+	bool is_property = false;
+	if (ClassDB::get_property_index(native_class, p_name, &is_property) != -1 || !is_property) {
+		return false;
+	}
+	r_entry.method = ClassDB::get_method(native_class, ClassDB::get_property_setter(native_class, p_name));
+	if (!r_entry.method) {
+		return false;
+	}
+	r_entry.kind = InlineCacheEntry::KIND_NATIVE_PROPERTY;
+	return true;
+}
+
+void GDScriptFunction::_call_inline_cached(const InlineCacheEntry *p_entry, Object *p_object, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	if (p_entry->kind == InlineCacheEntry::KIND_SCRIPT_FUNCTION) {
+		r_ret = p_entry->function->call(static_cast<GDScriptInstance *>(p_object->get_script_instance()), p_args, p_argcount, r_error);
+	} else {
+		r_ret = p_entry->method->call(p_object, p_args, p_argcount, r_error);
+	}
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -232,6 +434,9 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,             \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,              \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -510,6 +715,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	Variant *stack = nullptr;
 	Variant **instruction_args = nullptr;
 	int defarg = 0;
+	bool stack_moved = false; // Handed to the state of an `await`, which owns it from now on.
 
 #ifdef DEBUG_ENABLED
 
@@ -524,11 +730,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -693,6 +899,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #define GET_INSTRUCTION_ARG(m_v, m_idx) \
 	Variant *m_v = instruction_args[m_idx]
 
+	// Only set while the sampling profiler runs, which also works in release builds.
+	GDScriptSamplingProfiler::ThreadStack *sampling_stack = nullptr;
+	if (unlikely(GDScriptSamplingProfiler::is_sampling())) {
+		sampling_stack = GDScriptSamplingProfiler::enter_function(this, ip);
+	}
+
 #ifdef DEBUG_ENABLED
 	uint64_t function_start_time = 0;
 	uint64_t function_call_time = 0;
@@ -822,6 +1034,72 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// The operator is known to return a bool, no need to booleanize.
+				if (*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(result, 2);
+				GET_VARIANT_PTR(dst, 4);
+
+				operator_func(a, b, result);
+				*dst = *result;
+
+				ip += 6;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1166,7 +1444,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1176,8 +1454,43 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-				dst->set_named(*index, *value, valid);
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
+				bool valid = false;
+				bool cached = false;
+				if (dst->get_type() == Variant::OBJECT) {
+					Object *obj = dst->get_validated_object();
+					if (obj) {
+						InlineCache &cache = _inline_caches_ptr[cache_idx];
+						InlineCacheEntry cached_entry;
+						const InlineCacheEntry *entry = _get_inline_cache_entry(cache, obj, cached_entry);
+						if (!entry) {
+							if (_resolve_inline_set(obj, *index, cached_entry)) {
+								entry = _add_inline_cache_entry(cache, cached_entry);
+							}
+						}
+						if (entry) {
+							if (entry->kind == InlineCacheEntry::KIND_SCRIPT_MEMBER) {
+								// Values needing a conversion go through `GDScriptInstance::set()`.
+								if (!entry->member_type->has_type || entry->member_type->is_type(*value)) {
+									static_cast<GDScriptInstance *>(obj->get_script_instance())->members.write[entry->member_index] = *value;
+									valid = true;
+									cached = true;
+								}
+							} else {
+								const Variant *args[1] = { value };
+								Callable::CallError ce;
+								entry->method->call(obj, args, 1, ce);
+								valid = ce.error == Callable::CallError::CALL_OK;
+								cached = true;
+							}
+						}
+					}
+				}
+				if (!cached) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1198,7 +1511,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1218,7 +1531,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1228,22 +1541,52 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
+				InlineCacheEntry cached_entry;
+				const InlineCacheEntry *entry = nullptr;
+				Object *obj = nullptr;
+				if (src->get_type() == Variant::OBJECT) {
+					obj = src->get_validated_object();
+					if (obj) {
+						InlineCache &cache = _inline_caches_ptr[cache_idx];
+						entry = _get_inline_cache_entry(cache, obj, cached_entry);
+						if (!entry) {
+							if (_resolve_inline_get(obj, *index, cached_entry)) {
+								entry = _add_inline_cache_entry(cache, cached_entry);
+							}
+						}
+					}
+				}
+
+				if (entry) {
+					if (entry->kind == InlineCacheEntry::KIND_SCRIPT_MEMBER) {
+						// Copy first, `dst` may be the only reference to the object.
+						Variant ret = static_cast<GDScriptInstance *>(obj->get_script_instance())->members[entry->member_index];
+						*dst = ret;
+					} else {
+						Callable::CallError ce;
+						*dst = entry->method->call(obj, nullptr, 0, ce);
+					}
+				} else {
+					bool valid;
 #ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+					//allow better error message in cases where src and dst are the same stack position
+					Variant ret = src->get_named(*index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+					*dst = src->get_named(*index, valid);
 #endif
 #ifdef DEBUG_ENABLED
-				if (!valid) {
-					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
-					OPCODE_BREAK;
-				}
-				*dst = ret;
+					if (!valid) {
+						err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
+						OPCODE_BREAK;
+					}
+					*dst = ret;
 #endif
-				ip += 4;
+				}
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1862,7 +2205,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1873,9 +2216,28 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
+				InlineCacheEntry cached_entry;
+				const InlineCacheEntry *cache_entry = nullptr;
+				Object *cache_obj = nullptr;
+				if (base->get_type() == Variant::OBJECT) {
+					cache_obj = base->get_validated_object();
+					if (cache_obj) {
+						InlineCache &cache = _inline_caches_ptr[cache_idx];
+						cache_entry = _get_inline_cache_entry(cache, cache_obj, cached_entry);
+						if (!cache_entry) {
+							if (_resolve_inline_call(cache_obj, *methodname, cached_entry)) {
+								cache_entry = _add_inline_cache_entry(cache, cached_entry);
+							}
+						}
+					}
+				}
+
 #ifdef DEBUG_ENABLED
 				uint64_t call_time = 0;
 
@@ -1891,7 +2253,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (cache_entry) {
+						_call_inline_cached(cache_entry, cache_obj, (const Variant **)argptrs, argc, temp_ret, err);
+					} else {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1920,6 +2286,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
+				} else if (cache_entry) {
+					_call_inline_cached(cache_entry, cache_obj, (const Variant **)argptrs, argc, temp_ret, err);
 				} else {
 					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
@@ -1971,7 +2339,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2537,12 +2905,21 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+					if (p_state) {
+						// Resumed from a previous await, the stack already lives in a frame. Hand it over.
+						gdfs->state.stack = p_state->stack;
+						gdfs->state.stack_capacity = p_state->stack_capacity;
+						p_state->stack = nullptr;
+						p_state->stack_capacity = 0;
+						p_state->stack_size = 0;
+					} else {
+						// Variants are trivially relocatable (CowData reallocates them in place as well), so the slots
+						// are moved to the frame without touching reference counts. First 3 stack addresses are special,
+						// so we just skip them here.
+						gdfs->state.stack = GDScriptCoroutineFramePool::allocate(alloca_size, gdfs->state.stack_capacity);
+						memcpy((void *)&gdfs->state.stack[sizeof(Variant) * FIXED_ADDRESSES_MAX], (const void *)&stack[FIXED_ADDRESSES_MAX], sizeof(Variant) * (_stack_size - FIXED_ADDRESSES_MAX));
 					}
+					stack_moved = true;
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.alloca_size = alloca_size;
 					gdfs->state.ip = ip + 2;
@@ -2665,6 +3042,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				CHECK_SPACE(2);
 				int to = _code_ptr[ip + 1];
 
+				// Jumps close every loop, which makes them good safe points for sampling.
+				if (unlikely(sampling_stack)) {
+					GDScriptSamplingProfiler::poll(sampling_stack, ip);
+				}
+
 				GD_ERR_BREAK(to < 0 || to > _code_size);
 				ip = to;
 			}
@@ -3863,6 +4245,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+	if (unlikely(sampling_stack)) {
+		GDScriptSamplingProfiler::exit_function(sampling_stack);
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -3885,8 +4271,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		if (!stack_moved) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
+			if (p_state) {
+				p_state->stack_size = 0; // Only the frame is left to release.
+			}
 		}
 #ifdef DEBUG_ENABLED
 	}
@@ -32,7 +32,9 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
@@ -50,6 +52,7 @@
 #include "tests/test_gdscript.h"
 #endif
 
+#include "core/config/engine.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
@@ -60,10 +63,6 @@
 #include "editor/editor_settings.h"
 #include "editor/editor_translation_parser.h"
 #include "editor/export/editor_export.h"
-
-#ifndef GDSCRIPT_NO_LSP
-#include "core/config/engine.h"
-#endif
 #endif // TOOLS_ENABLED
 
 #ifdef TESTS_ENABLED
@@ -74,6 +73,7 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+GDScriptSamplingProfiler *gdscript_sampling_profiler = nullptr;
 
 #ifdef TOOLS_ENABLED
 
@@ -156,6 +156,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		gdscript_cache = memnew(GDScriptCache);
 
+		GDREGISTER_CLASS(GDScriptSamplingProfiler);
+		gdscript_sampling_profiler = memnew(GDScriptSamplingProfiler);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("GDScriptSamplingProfiler", GDScriptSamplingProfiler::get_singleton()));
+
 		GDScriptUtilityFunctions::register_functions();
 	}
 
@@ -184,6 +188,12 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 			memdelete(gdscript_cache);
 		}
 
+		if (gdscript_sampling_profiler) {
+			memdelete(gdscript_sampling_profiler);
+		}
+
+		GDScriptBytecodeCache::clear();
+
 		if (script_language_gd) {
 			memdelete(script_language_gd);
 		}
@@ -195,6 +205,7 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 		resource_saver_gd.unref();
 
 		GDScriptParser::cleanup();
+		GDScriptCoroutineFramePool::clear();
 		GDScriptUtilityFunctions::unregister_functions();
 	}
 
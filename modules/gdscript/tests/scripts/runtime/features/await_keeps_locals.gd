@@ -0,0 +1,29 @@
+signal tick(value)
+
+func accumulate():
+	var values := []
+	var label := "sum"
+	var total := 0
+	for i in 3:
+		var value = await tick
+		values.append(value)
+		total += value
+	print("%s of %s = %d" % [label, values, total])
+	return total
+
+func wrapper():
+	var prefix := "wrapped"
+	var result = await accumulate()
+	print(prefix, " ", result)
+
+func test():
+	wrapper()
+	tick.emit(1)
+	tick.emit(2)
+	tick.emit(3)
+
+	# A second round reuses the frames released by the first one.
+	wrapper()
+	tick.emit(10)
+	tick.emit(20)
+	tick.emit(30)
@@ -0,0 +1,43 @@
+# Typed comparisons consumed by a branch and typed operations stored right away
+# are emitted as fused instructions. Check they keep the same semantics.
+
+var member_count: int = 0
+var member_position := Vector2(1, 1)
+
+func test():
+	var i := 0
+	var total := 0
+	while i < 10:
+		if i % 2 == 0:
+			total += i
+		else:
+			total -= 1
+		i += 1
+	print(total)
+
+	var a := 3
+	var b := 5
+	print(a < b and b < 10)
+	print(a > b and b < 10)
+	print(a > b or b == 5)
+	print(a > b or b != 5)
+	print("yes" if a * 2 > b else "no")
+	print("yes" if a * 2 < b else "no")
+
+	for j in 4:
+		member_count += j
+		member_position *= 2.0
+	print(member_count)
+	print(member_position)
+
+	var v := Vector3(1, 2, 3)
+	var w := v + Vector3.ONE
+	v = v * 2.0
+	print(v, " ", w)
+
+	var s := "a"
+	var n := 0
+	while s.length() < 4:
+		s = s + "b"
+		n += 1
+	print(s, " ", n)
@@ -0,0 +1,66 @@
+# Untyped calls and property accesses cache how they were resolved for the last
+# receiver. Make sure they still resolve correctly when the receiver changes.
+
+class A:
+	var value = 1
+	var typed: int = 10
+	func describe():
+		return "A %d" % value
+
+class B extends A:
+	func describe():
+		return "B %d" % value
+
+class C:
+	var value = "c"
+	var _hidden = 0
+	func describe():
+		return "C " + value
+
+class WithSetter:
+	var value = 0:
+		set(v):
+			value = v * 2
+	func describe():
+		return "WithSetter %d" % value
+
+func describe_all(list):
+	for item in list:
+		print(item.describe())
+
+func bump_all(list):
+	for item in list:
+		item.value = item.value + item.value
+
+func test():
+	var a = A.new()
+	var b = B.new()
+	b.value = 2
+	var c = C.new()
+	var s = WithSetter.new()
+	s.value = 3
+
+	var list = [a, a, b, b, c, s, a]
+	describe_all(list)
+	bump_all([a, b, s, c])
+	describe_all([a, b, s, c])
+
+	# Typed member: values needing conversion still get converted.
+	for value in [5, 6.0, 7]:
+		a.typed = value
+		print(a.typed, " ", typeof(a.typed) == TYPE_INT)
+
+	# Native methods and properties.
+	var nodes = [Node.new(), Node2D.new(), Node.new()]
+	for node in nodes:
+		node.name = "Node_%s" % node.get_class()
+		print(node.name, " ", node.get_child_count())
+	for node in nodes:
+		node.free()
+
+	# Compiling scripts invalidates all cached entries, sites start over instead of giving up.
+	for i in 5:
+		var script := GDScript.new()
+		script.source_code = "extends RefCounted\nfunc describe():\n\treturn \"Compiled %d\"\n" % i
+		script.reload()
+		describe_all([a, b, script.new()])
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_cache.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_BYTECODE_CACHE_H
+#define TEST_GDSCRIPT_BYTECODE_CACHE_H
+
+#include "../gdscript.h"
+#include "../gdscript_bytecode_cache.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGDScriptBytecodeCache {
+
+static const char *cache_test_source = R"(
+extends RefCounted
+
+const SCALE = 3
+const NAMES: Array[String] = ["a", "b", "c"]
+const LOOKUP = { "x": 1, "y": 2 }
+
+class Accumulator:
+	var total := 0
+
+	func add(value: int) -> void:
+		total += value
+
+var offset := 5
+
+func run(n: int) -> int:
+	var accumulator := Accumulator.new()
+	var twice := func(value: int) -> int: return value * 2
+	for i in n:
+		accumulator.add(twice.call(i) * SCALE)
+	return accumulator.total + offset + NAMES.size() + LOOKUP["y"]
+)";
+
+static Ref<GDScript> compile_script(const String &p_source) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The test script should compile.");
+	return gdscript;
+}
+
+static Variant call_run(const Ref<GDScript> &p_script, int p_n) {
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(p_script);
+	return instance->call("run", p_n);
+}
+
+TEST_SUITE("[Modules][GDScript][Bytecode cache]") {
+	TEST_CASE("Round trip preserves behavior") {
+		const Ref<GDScript> compiled = compile_script(cache_test_source);
+		const Vector<uint8_t> data = GDScriptBytecodeCache::serialize(compiled.ptr(), HashSet<String>());
+		REQUIRE_MESSAGE(!data.is_empty(), "The script should be serializable.");
+
+		Ref<GDScript> loaded = memnew(GDScript);
+		loaded->set_source_code(cache_test_source);
+		REQUIRE(GDScriptBytecodeCache::deserialize(loaded.ptr(), data, false) == OK);
+		CHECK(loaded->is_valid());
+		CHECK(loaded->has_method("run"));
+
+		CHECK(int64_t(call_run(loaded, 10)) == int64_t(call_run(compiled, 10)));
+		CHECK(int64_t(call_run(loaded, 100)) == 29710);
+		CHECK(!GDScriptBytecodeCache::serialize(loaded.ptr(), HashSet<String>()).is_empty());
+	}
+
+	TEST_CASE("Invalid entries are rejected") {
+		const Ref<GDScript> compiled = compile_script(cache_test_source);
+		const Vector<uint8_t> data = GDScriptBytecodeCache::serialize(compiled.ptr(), HashSet<String>());
+		REQUIRE(!data.is_empty());
+
+		Vector<uint8_t> bad_magic = data;
+		bad_magic.write[0] = 'X';
+		Ref<GDScript> script_a = memnew(GDScript);
+		CHECK(GDScriptBytecodeCache::deserialize(script_a.ptr(), bad_magic, false) != OK);
+
+		Vector<uint8_t> bad_version = data;
+		bad_version.write[4] = uint8_t(GDScriptBytecodeCache::FORMAT_VERSION + 1);
+		Ref<GDScript> script_b = memnew(GDScript);
+		CHECK(GDScriptBytecodeCache::deserialize(script_b.ptr(), bad_version, false) != OK);
+
+		Ref<GDScript> script_c = memnew(GDScript);
+		CHECK(GDScriptBytecodeCache::deserialize(script_c.ptr(), data.slice(0, data.size() / 2), false) != OK);
+
+		Vector<uint8_t> bad_body = data;
+		bad_body.write[data.size() - 1] ^= 0xFF;
+		Ref<GDScript> script_d = memnew(GDScript);
+		CHECK(GDScriptBytecodeCache::deserialize(script_d.ptr(), bad_body, false) != OK);
+	}
+
+	// Compares compiling from source with loading the cached bytecode, the part of startup the cache removes.
+	// Run with `--test --no-skip --test-case="*Bytecode cache*"`.
+	TEST_CASE("Load time benchmark" * doctest::skip()) {
+		const int script_count = 200;
+		const Ref<GDScript> compiled = compile_script(cache_test_source);
+		const Vector<uint8_t> data = GDScriptBytecodeCache::serialize(compiled.ptr(), HashSet<String>());
+		REQUIRE(!data.is_empty());
+
+		uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < script_count; i++) {
+			compile_script(cache_test_source);
+		}
+		const uint64_t compile_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+		start_usec = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < script_count; i++) {
+			Ref<GDScript> loaded = memnew(GDScript);
+			REQUIRE(GDScriptBytecodeCache::deserialize(loaded.ptr(), data, false) == OK);
+		}
+		const uint64_t load_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+		MESSAGE(vformat("Compiling %d scripts: %d usec, loading them from the bytecode cache: %d usec (%d bytes each).", script_count, compile_usec, load_usec, data.size()));
+	}
+}
+
+} // namespace TestGDScriptBytecodeCache
+
+#endif // TEST_GDSCRIPT_BYTECODE_CACHE_H
@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_CACHE_H
+#define TEST_GDSCRIPT_CACHE_H
+
+#include "../gdscript_cache.h"
+
+#include "core/io/file_access.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDScriptCache {
+
+static String write_script(const String &p_name, const String &p_source) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(p_source);
+	return path;
+}
+
+TEST_SUITE("[Modules][GDScript][Cache]") {
+	TEST_CASE("Dependencies are parsed ahead of the analysis") {
+		write_script("gdscript_cache_base.gd", "extends RefCounted\n\nfunc base_value() -> int:\n\treturn 1\n");
+		write_script("gdscript_cache_leaf.gd", "extends RefCounted\n\nconst VALUE = 10\n");
+		write_script("gdscript_cache_middle.gd", "extends RefCounted\n\nconst Leaf = preload(\"gdscript_cache_leaf.gd\")\n");
+		write_script("gdscript_cache_other.gd", "extends RefCounted\n\nconst VALUE = 100\n");
+		const String main_path = write_script("gdscript_cache_main.gd", R"(extends "gdscript_cache_base.gd"
+
+const Middle = preload("gdscript_cache_middle.gd")
+var other = preload("gdscript_cache_other.gd")
+
+func run() -> int:
+	return base_value() + Middle.Leaf.VALUE + other.VALUE
+)");
+
+		{
+			const Vector<Ref<GDScriptParserRef>> parsed = GDScriptCache::parse_dependencies(main_path);
+			CHECK(parsed.size() == 5);
+			for (const Ref<GDScriptParserRef> &parser_ref : parsed) {
+				CHECK(parser_ref->get_status() == GDScriptParserRef::PARSED);
+				CHECK(GDScriptCache::has_parser(parser_ref->get_path()));
+			}
+		}
+		// The parsers are only kept while somebody holds them.
+		CHECK_FALSE(GDScriptCache::has_parser(main_path));
+
+		Error error = OK;
+		Ref<GDScript> script = GDScriptCache::get_full_script(main_path, error);
+		REQUIRE(error == OK);
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(script);
+		CHECK(int(instance->call("run")) == 111);
+
+		GDScriptCache::remove_script(main_path);
+	}
+}
+
+} // namespace TestGDScriptCache
+
+#endif // TEST_GDSCRIPT_CACHE_H
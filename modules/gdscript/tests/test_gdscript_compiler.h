@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  test_gdscript_compiler.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_COMPILER_H
+#define TEST_GDSCRIPT_COMPILER_H
+
+#include "../gdscript.h"
+
+#include "core/config/project_settings.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGDScriptCompiler {
+
+static const char *optimized_source = R"(
+extends RefCounted
+
+static func square(x: float) -> float:
+	return x * x
+
+static func mix(a: Vector2, b: Vector2, weight: float) -> Vector2:
+	return a + (b - a) * clampf(weight, 0.0, 1.0)
+
+func run(value: float) -> float:
+	var scale := 2.0
+	var label := "result"
+	var offset := mix(Vector2.ZERO, Vector2(10, 20), 0.5)
+	return square(value) * scale + offset.y + len(label)
+)";
+
+struct DisassemblyCapture {
+	PrintHandlerList handler;
+	String text;
+
+	static void print(void *p_this, const String &p_message, bool p_error, bool p_rich) {
+		static_cast<DisassemblyCapture *>(p_this)->text += p_message + "\n";
+	}
+
+	DisassemblyCapture() {
+		handler.printfunc = print;
+		handler.userdata = this;
+	}
+};
+
+static Ref<GDScript> compile_script(bool p_optimize) {
+	ProjectSettings::get_singleton()->set_setting("gdscript/compiler/optimize", p_optimize);
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(optimized_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	ProjectSettings::get_singleton()->set_setting("gdscript/compiler/optimize", false);
+	REQUIRE_MESSAGE(error == OK, "The test script should compile.");
+	return gdscript;
+}
+
+static Variant call_run(const Ref<GDScript> &p_script, float p_value) {
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(p_script);
+	return instance->call("run", p_value);
+}
+
+#ifdef DEBUG_ENABLED
+static String disassemble_run(const Ref<GDScript> &p_script) {
+	const HashMap<StringName, GDScriptFunction *>::ConstIterator E = p_script->get_member_functions().find("run");
+	REQUIRE(E);
+	DisassemblyCapture capture;
+	add_print_handler(&capture.handler);
+	E->value->disassemble(String(optimized_source).split("\n"));
+	remove_print_handler(&capture.handler);
+	return capture.text;
+}
+#endif
+
+TEST_SUITE("[Modules][GDScript][Compiler]") {
+	TEST_CASE("Optimizations keep the behavior") {
+		const Ref<GDScript> plain = compile_script(false);
+		const Ref<GDScript> optimized = compile_script(true);
+
+		CHECK(double(call_run(plain, 3.0)) == doctest::Approx(34.0));
+		CHECK(double(call_run(optimized, 3.0)) == doctest::Approx(34.0));
+		CHECK(double(call_run(optimized, -1.5)) == doctest::Approx(20.5));
+	}
+
+#ifdef DEBUG_ENABLED
+	TEST_CASE("Optimized disassembly") {
+		const String plain = disassemble_run(compile_script(false));
+		const String optimized = disassemble_run(compile_script(true));
+
+		// Small static functions are inlined.
+		CHECK(plain.contains(".square("));
+		CHECK(plain.contains(".mix("));
+		CHECK_FALSE(optimized.contains(".square("));
+		CHECK_FALSE(optimized.contains(".mix("));
+		CHECK(optimized.contains("clampf"));
+
+		// Locals initialized with a constant and never modified are read as constants, without a store.
+		CHECK_FALSE(plain.contains("len(const("));
+		CHECK(optimized.contains("len(const("));
+
+		CHECK(optimized.count("\n") < plain.count("\n"));
+	}
+#endif
+}
+
+} // namespace TestGDScriptCompiler
+
+#endif // TEST_GDSCRIPT_COMPILER_H
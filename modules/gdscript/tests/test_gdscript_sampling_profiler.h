@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  test_gdscript_sampling_profiler.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_SAMPLING_PROFILER_H
+#define TEST_GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "../gdscript.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGDScriptSamplingProfiler {
+
+static const char *profiled_source = R"(
+extends RefCounted
+
+func spin(tick: Callable, count: int) -> int:
+	var i := 0
+	while i < count:
+		tick.call()
+		i += 1
+	return i
+
+func run(tick: Callable, count: int) -> int:
+	return spin(tick, count)
+)";
+
+TEST_SUITE("[Modules][GDScript][SamplingProfiler]") {
+	TEST_CASE("Line mapping of compiled functions") {
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(profiled_source);
+		REQUIRE(gdscript->reload() == OK);
+
+		const HashMap<StringName, GDScriptFunction *>::ConstIterator E = gdscript->get_member_functions().find("spin");
+		REQUIRE(E);
+		// The function starts on line 4, and its last statement is on line 9.
+		CHECK(E->value->get_line_at(-1) == 4);
+		CHECK(E->value->get_line_at(INT32_MAX) == 9);
+	}
+
+	TEST_CASE("Samples are attributed to the running functions") {
+		GDScriptSamplingProfiler *profiler = GDScriptSamplingProfiler::get_singleton();
+		REQUIRE(profiler);
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(profiled_source);
+		REQUIRE(gdscript->reload() == OK);
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(gdscript);
+
+		// Without a timer, the script requests one sample per loop iteration, which is
+		// recorded when the loop jumps back after the call.
+		const Callable tick = callable_mp_static(&GDScriptSamplingProfiler::request_sample);
+
+		profiler->clear();
+		REQUIRE(profiler->start(0) == OK);
+		CHECK(profiler->is_running());
+		ERR_PRINT_OFF;
+		CHECK(profiler->start() == ERR_ALREADY_IN_USE);
+		ERR_PRINT_ON;
+		instance->call("run", tick, 3);
+		profiler->stop();
+		CHECK_FALSE(profiler->is_running());
+
+		CHECK(profiler->get_sample_count() == 3);
+		CHECK(profiler->get_collapsed_stacks() == "run (<built-in>);spin (<built-in>:8) 3\n");
+
+		// Nothing is recorded once stopped.
+		instance->call("run", tick, 3);
+		CHECK(profiler->get_sample_count() == 3);
+
+		profiler->clear();
+		CHECK(profiler->get_sample_count() == 0);
+		CHECK(profiler->get_collapsed_stacks().is_empty());
+	}
+}
+
+} // namespace TestGDScriptSamplingProfiler
+
+#endif // TEST_GDSCRIPT_SAMPLING_PROFILER_H
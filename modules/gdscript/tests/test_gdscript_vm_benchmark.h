@@ -0,0 +1,195 @@
+/**************************************************************************/
+/*  test_gdscript_vm_benchmark.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_VM_BENCHMARK_H
+#define TEST_GDSCRIPT_VM_BENCHMARK_H
+
+#include "../gdscript.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+// Micro-benchmarks for the GDScript VM. They are skipped by default since their only
+// output is timing information, run them with `--test --no-skip --test-case="*VM benchmark*"`.
+// Each script exposes `run(n)`, which executes `n` iterations of the measured loop.
+
+namespace TestGDScriptVMBenchmark {
+
+static Variant run_benchmark(const String &p_name, const String &p_source, int p_iterations) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should compile.");
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(gdscript);
+
+	// Warm up caches before measuring.
+	instance->call("run", p_iterations / 10);
+
+	const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	const Variant result = instance->call("run", p_iterations);
+	const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	MESSAGE(vformat("%s: %.2f ns per iteration (%d iterations in %d usec).", p_name, elapsed_usec * 1000.0 / p_iterations, p_iterations, elapsed_usec));
+	return result;
+}
+
+TEST_SUITE("[Modules][GDScript][VM benchmark]") {
+	TEST_CASE("Integer loop" * doctest::skip()) {
+		const Variant result = run_benchmark("Integer loop", R"(
+extends RefCounted
+
+func run(n: int) -> int:
+	var i := 0
+	var sum := 0
+	while i < n:
+		if i % 3 == 0:
+			sum += i
+		i += 1
+	return sum
+)",
+				3000000);
+		CHECK(int64_t(result) == 1499998500000);
+	}
+
+	TEST_CASE("Vector math" * doctest::skip()) {
+		const Variant result = run_benchmark("Vector math", R"(
+extends RefCounted
+
+func run(n: int) -> Vector3:
+	var position := Vector3.ZERO
+	var velocity := Vector3(1.0, 0.5, 0.25)
+	var delta := 0.001
+	for i in n:
+		velocity = velocity * 0.999 + Vector3.DOWN * delta
+		position += velocity * delta
+	return position
+)",
+				1000000);
+		CHECK(Vector3(result).is_finite());
+	}
+
+	TEST_CASE("Dictionary access" * doctest::skip()) {
+		const Variant result = run_benchmark("Dictionary access", R"(
+extends RefCounted
+
+func run(n: int) -> int:
+	var dict := {}
+	for i in 64:
+		dict[i] = i
+	var sum := 0
+	for i in n:
+		var key := i & 63
+		sum += dict[key]
+		dict[key] = sum & 0xFFFF
+	return dict.size()
+)",
+				1000000);
+		CHECK(int(result) == 64);
+	}
+
+	TEST_CASE("Method calls" * doctest::skip()) {
+		const Variant result = run_benchmark("Method calls", R"(
+extends RefCounted
+
+var counter := 0
+
+func step(amount: int) -> int:
+	counter += amount
+	return counter
+
+func run(n: int) -> int:
+	counter = 0
+	var last := 0
+	for i in n:
+		last = step(1)
+	return last
+)",
+				1000000);
+		CHECK(int(result) == 1000000);
+	}
+
+	TEST_CASE("Await resume" * doctest::skip()) {
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(R"(
+extends RefCounted
+
+signal tick
+
+var resumes := 0
+
+func worker() -> void:
+	var position := Vector2.ZERO
+	var path: Array[Vector2] = [Vector2.ONE]
+	while true:
+		await tick
+		position += path[0]
+		resumes += 1
+
+func start(count: int) -> void:
+	for i in count:
+		worker()
+
+func run(n: int) -> int:
+	for i in n:
+		tick.emit()
+	return resumes
+)");
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The benchmark script should compile.");
+
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(gdscript);
+
+		const int coroutines = 1000;
+		const int frames = 500;
+		instance->call("start", coroutines);
+		instance->call("run", 10); // Warm up the frame pool.
+
+		const uint64_t start_bytes = GDScriptCoroutineFramePool::get_allocated_bytes();
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		const int resumes = int(instance->call("run", frames)) - coroutines * 10;
+		const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		const uint64_t frame_bytes = GDScriptCoroutineFramePool::get_allocated_bytes() - start_bytes;
+
+		MESSAGE(vformat("Await resume: %.0f awaits per second, %.2f frame bytes allocated per resume (%d resumes in %d usec).", resumes * 1000000.0 / elapsed_usec, double(frame_bytes) / resumes, resumes, elapsed_usec));
+		CHECK(resumes == coroutines * frames);
+	}
+}
+
+} // namespace TestGDScriptVMBenchmark
+
+#endif // TEST_GDSCRIPT_VM_BENCHMARK_H
@@ -170,6 +170,27 @@ void GodotBody3D::reset_mass_properties() {
 	_mass_properties_changed();
 }
 
+void GodotBody3D::add_constraint(GodotConstraint3D *p_constraint, int p_pos) {
+	constraint_map[p_constraint] = p_pos;
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotBody3D::remove_constraint(GodotConstraint3D *p_constraint) {
+	constraint_map.erase(p_constraint);
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotBody3D::clear_constraint_map() {
+	constraint_map.clear();
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
 void GodotBody3D::set_active(bool p_active) {
 	if (active == p_active) {
 		return;
@@ -299,6 +320,11 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 	PhysicsServer3D::BodyMode prev = mode;
 	mode = p_mode;
 
+	if (get_space()) {
+		// Static bodies don't connect islands.
+		get_space()->invalidate_islands();
+	}
+
 	switch (p_mode) {
 		case PhysicsServer3D::BODY_MODE_STATIC:
 		case PhysicsServer3D::BODY_MODE_KINEMATIC: {
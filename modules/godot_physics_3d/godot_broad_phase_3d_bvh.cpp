@@ -32,6 +32,9 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -114,12 +117,23 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
+void GodotBroadPhase3DBVH::_parallel_for(void (*p_task)(void *, uint32_t), void *p_task_userdata, uint32_t p_count) {
+	WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(p_task, p_task_userdata, p_count, p_count, true, "BVHPairing");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+}
+
 void GodotBroadPhase3DBVH::update() {
-	bvh.update();
+	if (threaded_update) {
+		bvh.update_threaded(_parallel_for, WorkerThreadPool::get_singleton()->get_thread_count());
+	} else {
+		bvh.update();
+	}
 }
 
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
-	return memnew(GodotBroadPhase3DBVH);
+	GodotBroadPhase3DBVH *broadphase = memnew(GodotBroadPhase3DBVH);
+	broadphase->set_threaded_update_enabled(GLOBAL_GET("physics/3d/threaded_broadphase_update"));
+	return broadphase;
 }
 
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
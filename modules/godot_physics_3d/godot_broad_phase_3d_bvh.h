@@ -73,6 +73,10 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	UnpairCallback unpair_callback = nullptr;
 	void *unpair_userdata = nullptr;
 
+	bool threaded_update = false;
+
+	static void _parallel_for(void (*p_task)(void *, uint32_t), void *p_task_userdata, uint32_t p_count);
+
 public:
 	// 0 is an invalid ID
 	virtual ID create(GodotCollisionObject3D *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) override;
@@ -93,6 +97,11 @@ public:
 
 	virtual void update() override;
 
+	// When enabled, the pairing queries of many moved proxies are spread over the WorkerThreadPool.
+	// The pair and unpair callbacks are called from the calling thread in a deterministic order either way.
+	void set_threaded_update_enabled(bool p_enabled) { threaded_update = p_enabled; }
+	bool is_threaded_update_enabled() const { return threaded_update; }
+
 	static GodotBroadPhase3D *_create();
 	GodotBroadPhase3DBVH();
 };
@@ -650,6 +650,13 @@ public:
 		shape_A->project_range(axis, *transform_A, min_A, max_A);
 		shape_B->project_range(axis, *transform_B, min_B, max_B);
 
+		return test_axis_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Same as test_axis(), for callers that already projected both shapes on a non-zero axis.
+	_FORCE_INLINE_ bool test_axis_range(const Vector3 &p_axis, real_t p_min_A, real_t p_max_A, real_t p_min_B, real_t p_max_B) {
+		real_t min_A = p_min_A, max_A = p_max_A, min_B = p_min_B, max_B = p_max_B;
+
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -664,7 +671,7 @@ public:
 		max_B -= (min_A + max_A) * 0.5;
 
 		if (min_B > 0.0 || max_B < 0.0) {
-			separator_axis = axis;
+			separator_axis = p_axis;
 			return false; // doesn't contain 0
 		}
 
@@ -677,12 +684,12 @@ public:
 		if (max_B < min_B) {
 			if (max_B < best_depth) {
 				best_depth = max_B;
-				best_axis = axis;
+				best_axis = p_axis;
 			}
 		} else {
 			if (min_B < best_depth) {
 				best_depth = min_B;
-				best_axis = -axis; // keep it as A axis
+				best_axis = -p_axis; // keep it as A axis
 			}
 		}
 
@@ -1082,12 +1089,44 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
+	// Most separated pairs are rejected on a face axis. Projecting both boxes on the face axes only
+	// needs the dot products between the axes of both boxes, so compute them once instead of
+	// transforming each axis into the space of both boxes like GodotBoxShape3D::project_range() does.
+
+	const Vector3 axes_A[3] = { p_transform_a.basis.get_column(0), p_transform_a.basis.get_column(1), p_transform_a.basis.get_column(2) };
+	const Vector3 axes_B[3] = { p_transform_b.basis.get_column(0), p_transform_b.basis.get_column(1), p_transform_b.basis.get_column(2) };
+	const Vector3 &half_extents_A = box_A->get_half_extents();
+	const Vector3 &half_extents_B = box_B->get_half_extents();
+
+	real_t dots_AA[3][3];
+	real_t dots_BB[3][3];
+	real_t dots_AB[3][3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			dots_AA[i][j] = Math::abs(axes_A[i].dot(axes_A[j]));
+			dots_BB[i][j] = Math::abs(axes_B[i].dot(axes_B[j]));
+			dots_AB[i][j] = Math::abs(axes_A[i].dot(axes_B[j]));
+		}
+	}
+
 	// test faces of A
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
+		const real_t length = Math::sqrt(dots_AA[i][i]);
+		if (Math::is_zero_approx(length)) {
+			if (!separator.test_axis(axes_A[i].normalized())) {
+				return;
+			}
+			continue;
+		}
 
-		if (!separator.test_axis(axis)) {
+		const Vector3 axis = axes_A[i] / length;
+		const real_t extent_A = (dots_AA[0][i] * half_extents_A.x + dots_AA[1][i] * half_extents_A.y + dots_AA[2][i] * half_extents_A.z) / length;
+		const real_t extent_B = (dots_AB[i][0] * half_extents_B.x + dots_AB[i][1] * half_extents_B.y + dots_AB[i][2] * half_extents_B.z) / length;
+		const real_t center_A = axis.dot(p_transform_a.origin);
+		const real_t center_B = axis.dot(p_transform_b.origin);
+
+		if (!separator.test_axis_range(axis, center_A - extent_A, center_A + extent_A, center_B - extent_B, center_B + extent_B)) {
 			return;
 		}
 	}
@@ -1095,9 +1134,21 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	// test faces of B
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
+		const real_t length = Math::sqrt(dots_BB[i][i]);
+		if (Math::is_zero_approx(length)) {
+			if (!separator.test_axis(axes_B[i].normalized())) {
+				return;
+			}
+			continue;
+		}
 
-		if (!separator.test_axis(axis)) {
+		const Vector3 axis = axes_B[i] / length;
+		const real_t extent_A = (dots_AB[0][i] * half_extents_A.x + dots_AB[1][i] * half_extents_A.y + dots_AB[2][i] * half_extents_A.z) / length;
+		const real_t extent_B = (dots_BB[0][i] * half_extents_B.x + dots_BB[1][i] * half_extents_B.y + dots_BB[2][i] * half_extents_B.z) / length;
+		const real_t center_A = axis.dot(p_transform_a.origin);
+		const real_t center_B = axis.dot(p_transform_b.origin);
+
+		if (!separator.test_axis_range(axis, center_A - extent_A, center_A + extent_A, center_B - extent_B, center_B + extent_B)) {
 			return;
 		}
 	}
@@ -165,7 +165,7 @@ public:
 	GodotSeparationRayShape3D();
 };
 
-class GodotSphereShape3D : public GodotShape3D {
+class GodotSphereShape3D final : public GodotShape3D {
 	real_t radius = 0.0;
 
 	void _setup(real_t p_radius);
@@ -192,7 +192,7 @@ public:
 	GodotSphereShape3D();
 };
 
-class GodotBoxShape3D : public GodotShape3D {
+class GodotBoxShape3D final : public GodotShape3D {
 	Vector3 half_extents;
 	void _setup(const Vector3 &p_half_extents);
 
@@ -217,7 +217,7 @@ public:
 	GodotBoxShape3D();
 };
 
-class GodotCapsuleShape3D : public GodotShape3D {
+class GodotCapsuleShape3D final : public GodotShape3D {
 	real_t height = 0.0;
 	real_t radius = 0.0;
 
@@ -246,7 +246,7 @@ public:
 	GodotCapsuleShape3D();
 };
 
-class GodotCylinderShape3D : public GodotShape3D {
+class GodotCylinderShape3D final : public GodotShape3D {
 	real_t height = 0.0;
 	real_t radius = 0.0;
 
@@ -1089,10 +1089,12 @@ const SelfList<GodotBody3D>::List &GodotSpace3D::get_active_body_list() const {
 
 void GodotSpace3D::body_add_to_active_list(SelfList<GodotBody3D> *p_body) {
 	active_list.add(p_body);
+	invalidate_islands();
 }
 
 void GodotSpace3D::body_remove_from_active_list(SelfList<GodotBody3D> *p_body) {
 	active_list.remove(p_body);
+	invalidate_islands();
 }
 
 void GodotSpace3D::body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body) {
@@ -1110,11 +1112,13 @@ GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 void GodotSpace3D::add_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	invalidate_islands();
 }
 
 void GodotSpace3D::remove_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(!objects.has(p_object));
 	objects.erase(p_object);
+	invalidate_islands();
 }
 
 const HashSet<GodotCollisionObject3D *> &GodotSpace3D::get_objects() const {
@@ -1155,10 +1159,12 @@ const SelfList<GodotSoftBody3D>::List &GodotSpace3D::get_active_soft_body_list()
 
 void GodotSpace3D::soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body) {
 	active_soft_body_list.add(p_soft_body);
+	invalidate_islands();
 }
 
 void GodotSpace3D::soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body) {
 	active_soft_body_list.remove(p_soft_body);
+	invalidate_islands();
 }
 
 void GodotSpace3D::call_queries() {
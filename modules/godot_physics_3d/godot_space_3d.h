@@ -64,6 +64,7 @@ class GodotSpace3D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
@@ -117,6 +118,7 @@ private:
 
 	int island_count = 0;
 	int active_objects = 0;
+	uint64_t island_version = 1;
 	int collision_pairs = 0;
 
 	RID static_global_body;
@@ -186,6 +188,11 @@ public:
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
+	// Bumped whenever the constraint graph or the set of active bodies changes,
+	// so the stepper knows when its cached islands must be regenerated.
+	_FORCE_INLINE_ void invalidate_islands() { island_version++; }
+	_FORCE_INLINE_ uint64_t get_island_version() const { return island_version; }
+
 	void set_active_objects(int p_active_objects) { active_objects = p_active_objects; }
 	int get_active_objects() const { return active_objects; }
 
@@ -41,9 +41,7 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
-void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_body->set_island_step(_step);
-
+void GodotStep3D::_visit_island_body(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		// Only rigid bodies are tested for activation.
 		p_body_island.push_back(p_body);
@@ -57,7 +55,7 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 
-		all_constraints.push_back(constraint);
+		body_constraints.push_back(constraint);
 
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
@@ -71,7 +69,8 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			other_body->set_island_step(_step);
+			island_body_stack.push_back(other_body);
 		}
 
 		// Find connected soft bodies.
@@ -80,14 +79,13 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (soft_body->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island);
+			soft_body->set_island_step(_step);
+			island_soft_body_stack.push_back(soft_body);
 		}
 	}
 }
 
-void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_soft_body->set_island_step(_step);
-
+void GodotStep3D::_visit_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	for (GodotConstraint3D *E : p_soft_body->get_constraints()) {
 		GodotConstraint3D *constraint = E;
 		if (constraint->get_island_step() == _step) {
@@ -96,7 +94,7 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 
-		all_constraints.push_back(constraint);
+		body_constraints.push_back(constraint);
 
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
@@ -107,9 +105,111 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 			if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(body, p_body_island, p_constraint_island);
+			body->set_island_step(_step);
+			island_body_stack.push_back(body);
+		}
+	}
+}
+
+void GodotStep3D::_populate_island(LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	// Flood fill from the objects already on the stacks. This is done iteratively,
+	// large piles of touching bodies could otherwise overflow the call stack.
+	while (!island_body_stack.is_empty() || !island_soft_body_stack.is_empty()) {
+		if (!island_body_stack.is_empty()) {
+			GodotBody3D *body = island_body_stack[island_body_stack.size() - 1];
+			island_body_stack.resize(island_body_stack.size() - 1);
+			_visit_island_body(body, p_body_island, p_constraint_island);
+		} else {
+			GodotSoftBody3D *soft_body = island_soft_body_stack[island_soft_body_stack.size() - 1];
+			island_soft_body_stack.resize(island_soft_body_stack.size() - 1);
+			_visit_island_soft_body(soft_body, p_constraint_island);
+		}
+	}
+}
+
+void GodotStep3D::_generate_body_islands(GodotSpace3D *p_space) {
+	body_island_count = 0;
+	body_constraint_island_count = 0;
+	body_constraints.clear();
+
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
+
+	const SelfList<GodotBody3D> *b = p_space->get_active_body_list().first();
+	while (b) {
+		GodotBody3D *body = b->self();
+
+		if (body->get_island_step() != _step) {
+			++body_island_count;
+			if (body_islands.size() < body_island_count) {
+				body_islands.resize(body_island_count);
+			}
+			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
+			body_island.clear();
+			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+
+			++body_constraint_island_count;
+			if (body_constraint_islands.size() < body_constraint_island_count) {
+				body_constraint_islands.resize(body_constraint_island_count);
+			}
+			LocalVector<GodotConstraint3D *> &constraint_island = body_constraint_islands[body_constraint_island_count - 1];
+			constraint_island.clear();
+			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+
+			body->set_island_step(_step);
+			island_body_stack.push_back(body);
+			_populate_island(body_island, constraint_island);
+
+			if (body_island.is_empty()) {
+				--body_island_count;
+			}
+
+			if (constraint_island.is_empty()) {
+				--body_constraint_island_count;
+			}
+		}
+		b = b->next();
+	}
+
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
+
+	const SelfList<GodotSoftBody3D> *sb = p_space->get_active_soft_body_list().first();
+	while (sb) {
+		GodotSoftBody3D *soft_body = sb->self();
+
+		if (soft_body->get_island_step() != _step) {
+			++body_island_count;
+			if (body_islands.size() < body_island_count) {
+				body_islands.resize(body_island_count);
+			}
+			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
+			body_island.clear();
+			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+
+			++body_constraint_island_count;
+			if (body_constraint_islands.size() < body_constraint_island_count) {
+				body_constraint_islands.resize(body_constraint_island_count);
+			}
+			LocalVector<GodotConstraint3D *> &constraint_island = body_constraint_islands[body_constraint_island_count - 1];
+			constraint_island.clear();
+			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+
+			soft_body->set_island_step(_step);
+			island_soft_body_stack.push_back(soft_body);
+			_populate_island(body_island, constraint_island);
+
+			if (body_island.is_empty()) {
+				--body_island_count;
+			}
+
+			if (constraint_island.is_empty()) {
+				--body_constraint_island_count;
+			}
 		}
+		sb = sb->next();
 	}
+
+	island_cache_space = p_space->get_self();
+	island_cache_version = p_space->get_island_version();
 }
 
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
@@ -221,18 +321,47 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* BROADPHASE */
+
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE BODIES */
+
+	// Resting bodies keep the same islands from one step to the next, so they are only
+	// regenerated when constraints or active bodies have been added or removed.
+	if (island_cache_space != p_space->get_self() || island_cache_version != p_space->get_island_version()) {
+		_generate_body_islands(p_space);
+	}
 
-	uint32_t island_count = 0;
+	uint32_t island_count = body_constraint_island_count;
+	if (constraint_islands.size() < island_count) {
+		constraint_islands.resize(island_count);
+	}
+
+	// Solving modifies the constraint islands, work on copies of the cached ones.
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		constraint_islands[island_index] = body_constraint_islands[island_index];
+	}
+
+	for (GodotConstraint3D *constraint : body_constraints) {
+		constraint->set_island_step(_step);
+		all_constraints.push_back(constraint);
+	}
+
+	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
 
 	const SelfList<GodotArea3D>::List &aml = p_space->get_moved_area_list();
 
@@ -258,81 +387,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
-
-	uint32_t body_island_count = 0;
-
-	while (b) {
-		GodotBody3D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		b = b->next();
-	}
-
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
-
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		sb = sb->next();
-	}
-
 	p_space->set_island_count((int)island_count);
 
 	{ //profile
@@ -412,6 +466,8 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	body_constraint_islands.reserve(ISLAND_COUNT_RESERVE);
+	body_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
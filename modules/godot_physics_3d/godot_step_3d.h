@@ -45,8 +45,22 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
-	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	// Islands of active bodies are kept between steps and only regenerated
+	// when the space reports a change in its constraint graph.
+	RID island_cache_space;
+	uint64_t island_cache_version = 0;
+	uint32_t body_island_count = 0;
+	uint32_t body_constraint_island_count = 0;
+	LocalVector<LocalVector<GodotConstraint3D *>> body_constraint_islands;
+	LocalVector<GodotConstraint3D *> body_constraints;
+
+	LocalVector<GodotBody3D *> island_body_stack;
+	LocalVector<GodotSoftBody3D *> island_soft_body_stack;
+
+	void _visit_island_body(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _visit_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _populate_island(LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _generate_body_islands(GodotSpace3D *p_space);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*  test_godot_broad_phase_3d_bvh.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_BROAD_PHASE_3D_BVH_H
+#define TEST_GODOT_BROAD_PHASE_3D_BVH_H
+
+#include "../godot_body_3d.h"
+#include "../godot_broad_phase_3d_bvh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotBroadPhase3DBVH {
+
+// Objects are identified by their index in the scene (-1 for the plane), so events
+// from separately built scenes can be compared.
+struct PairEvent {
+	int a = 0;
+	int b = 0;
+	bool pair = false;
+
+	bool operator==(const PairEvent &p_other) const {
+		return a == p_other.a && b == p_other.b && pair == p_other.pair;
+	}
+};
+
+static bool events_match(const LocalVector<PairEvent> &p_a, const LocalVector<PairEvent> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_a.size(); i++) {
+		if (!(p_a[i] == p_b[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Benchmark scene: a grid of unit boxes falling from different heights onto a static plane,
+// drifting sideways so pairs keep being created and destroyed among neighbors.
+class FallingBoxesScene {
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<GodotBroadPhase3D::ID> ids;
+	LocalVector<Vector3> positions;
+	LocalVector<Vector3> velocities;
+	GodotBody3D *plane = nullptr;
+	GodotBroadPhase3D::ID plane_id = 0;
+	HashMap<GodotCollisionObject3D *, int> indices;
+
+	static void *_pair_callback(GodotCollisionObject3D *p_a, int p_subindex_a, GodotCollisionObject3D *p_b, int p_subindex_b, void *p_userdata) {
+		FallingBoxesScene *scene = (FallingBoxesScene *)p_userdata;
+		scene->events.push_back({ scene->indices.get(p_a), scene->indices.get(p_b), true });
+		return nullptr;
+	}
+
+	static void _unpair_callback(GodotCollisionObject3D *p_a, int p_subindex_a, GodotCollisionObject3D *p_b, int p_subindex_b, void *p_data, void *p_userdata) {
+		FallingBoxesScene *scene = (FallingBoxesScene *)p_userdata;
+		scene->events.push_back({ scene->indices.get(p_a), scene->indices.get(p_b), false });
+	}
+
+public:
+	GodotBroadPhase3DBVH broadphase;
+	LocalVector<PairEvent> events;
+	uint64_t update_usec = 0;
+
+	void step(real_t p_delta) {
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			velocities[i].y -= 9.8 * p_delta;
+			positions[i] += velocities[i] * p_delta;
+			if (positions[i].y < 0.5) {
+				positions[i].y = 0.5;
+				velocities[i].y = 0.0;
+			}
+			broadphase.move(ids[i], AABB(positions[i] - Vector3(0.5, 0.5, 0.5), Vector3(1, 1, 1)));
+		}
+
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		broadphase.update();
+		update_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+	}
+
+	FallingBoxesScene(int p_side, bool p_threaded) {
+		broadphase.set_threaded_update_enabled(p_threaded);
+		broadphase.set_pair_callback(_pair_callback, this);
+		broadphase.set_unpair_callback(_unpair_callback, this);
+
+		plane = memnew(GodotBody3D);
+		indices[plane] = -1;
+		plane_id = broadphase.create(plane, 0, AABB(Vector3(-p_side * 2, -1, -p_side * 2), Vector3(p_side * 4, 1, p_side * 4)), true);
+
+		for (int x = 0; x < p_side; x++) {
+			for (int z = 0; z < p_side; z++) {
+				int i = bodies.size();
+				positions.push_back(Vector3(x * 1.5, 2.0 + (i % 7) * 0.75, z * 1.5));
+				velocities.push_back(Vector3((i % 3) - 1.0, 0.0, ((i / 3) % 3) - 1.0) * 0.5);
+				bodies.push_back(memnew(GodotBody3D));
+				indices[bodies[i]] = i;
+				ids.push_back(broadphase.create(bodies[i], 0, AABB(positions[i] - Vector3(0.5, 0.5, 0.5), Vector3(1, 1, 1)), false));
+			}
+		}
+		broadphase.update();
+	}
+
+	~FallingBoxesScene() {
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			broadphase.remove(ids[i]);
+			memdelete(bodies[i]);
+		}
+		broadphase.remove(plane_id);
+		memdelete(plane);
+	}
+};
+
+static bool run_scenes_match(int p_side, int p_steps, bool p_print_timing) {
+	const real_t delta = 1.0 / 60.0;
+
+	FallingBoxesScene serial(p_side, false);
+	FallingBoxesScene threaded(p_side, true);
+
+	CHECK_MESSAGE(serial.events.size() > 0, "The falling boxes should be paired with the plane at least.");
+	CHECK(events_match(serial.events, threaded.events));
+
+	bool same_events = true;
+	uint32_t total_events = 0;
+	for (int i = 0; i < p_steps; i++) {
+		serial.events.clear();
+		threaded.events.clear();
+		serial.step(delta);
+		threaded.step(delta);
+		//Reduce number of check messages
+		same_events &= events_match(serial.events, threaded.events);
+		total_events += serial.events.size();
+	}
+	CHECK_MESSAGE(total_events > 0, "Boxes drifting sideways should pair and unpair among each other.");
+
+	if (p_print_timing) {
+		MESSAGE(vformat("Broadphase for %d boxes: %.3f ms per step serial, %.3f ms per step threaded.", p_side * p_side, serial.update_usec / 1000.0 / p_steps, threaded.update_usec / 1000.0 / p_steps));
+	}
+	return same_events;
+}
+
+TEST_CASE("[Physics3D][BVH] Threaded broadphase update sends the same pairs as the serial one") {
+	// 256 boxes, enough moved items for the pairing queries to be split into tasks.
+	CHECK_MESSAGE(run_scenes_match(16, 30, false), "Pair and unpair callbacks should happen in the same order.");
+}
+
+// Run with `--test --no-skip --test-case="*Threaded broadphase update benchmark*"`
+TEST_CASE("[Physics3D][BVH] Threaded broadphase update benchmark" * doctest::skip()) {
+	CHECK_MESSAGE(run_scenes_match(48, 120, true), "Pair and unpair callbacks should happen in the same order.");
+}
+
+} // namespace TestGodotBroadPhase3DBVH
+
+#endif // TEST_GODOT_BROAD_PHASE_3D_BVH_H
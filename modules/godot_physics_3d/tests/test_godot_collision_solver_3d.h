@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_godot_collision_solver_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_COLLISION_SOLVER_3D_H
+#define TEST_GODOT_COLLISION_SOLVER_3D_H
+
+#include "../gjk_epa.h"
+#include "../godot_collision_solver_3d.h"
+#include "../godot_collision_solver_3d_sat.h"
+#include "../godot_shape_3d.h"
+
+#include "core/math/random_number_generator.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionSolver3D {
+
+static void count_contacts(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	(*(int *)p_userdata)++;
+}
+
+struct Contact {
+	Vector3 point_a;
+	Vector3 point_b;
+	Vector3 normal;
+};
+
+static void collect_contacts(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	((LocalVector<Contact> *)p_userdata)->push_back({ p_point_A, p_point_B, normal });
+}
+
+// Plain separating axis test on the 15 candidate axes of two boxes, without margins.
+// Returns the smallest overlap of their projections, negative when the boxes are separated.
+static real_t reference_box_box_overlap(const Vector3 &p_half_extents_a, const Transform3D &p_transform_a, const Vector3 &p_half_extents_b, const Transform3D &p_transform_b) {
+	LocalVector<Vector3> axes;
+	for (int i = 0; i < 3; i++) {
+		axes.push_back(p_transform_a.basis.get_column(i));
+		axes.push_back(p_transform_b.basis.get_column(i));
+	}
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			const Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
+			if (!Math::is_zero_approx(axis.length_squared())) {
+				axes.push_back(axis);
+			}
+		}
+	}
+
+	const Vector3 delta = p_transform_b.origin - p_transform_a.origin;
+	real_t overlap = 1e15;
+	for (const Vector3 &axis : axes) {
+		const Vector3 normal = axis.normalized();
+		real_t radius_a = 0.0;
+		real_t radius_b = 0.0;
+		for (int i = 0; i < 3; i++) {
+			radius_a += Math::abs(normal.dot(p_transform_a.basis.get_column(i))) * p_half_extents_a[i];
+			radius_b += Math::abs(normal.dot(p_transform_b.basis.get_column(i))) * p_half_extents_b[i];
+		}
+		overlap = MIN(overlap, radius_a + radius_b - Math::abs(normal.dot(delta)));
+	}
+	return overlap;
+}
+
+static Transform3D random_transform(Ref<RandomNumberGenerator> p_rng, real_t p_spread) {
+	Vector3 axis = Vector3(p_rng->randf_range(-1, 1), p_rng->randf_range(-1, 1), p_rng->randf_range(-1, 1));
+	if (axis.is_zero_approx()) {
+		axis = Vector3(0, 1, 0);
+	}
+	Basis basis(axis.normalized(), p_rng->randf_range(-Math_PI, Math_PI));
+	Vector3 origin(p_rng->randf_range(-p_spread, p_spread), p_rng->randf_range(-p_spread, p_spread), p_rng->randf_range(-p_spread, p_spread));
+	return Transform3D(basis, origin);
+}
+
+TEST_CASE("[Physics3D][CollisionSolver] Box-box contacts agree with GJK on random pairs") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	GodotBoxShape3D box_a;
+	GodotBoxShape3D box_b;
+
+	int separated_count = 0;
+	int colliding_count = 0;
+	bool all_separated_agree = true;
+	bool all_colliding_agree = true;
+
+	for (int i = 0; i < 2000; i++) {
+		box_a.set_data(Vector3(rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0)));
+		box_b.set_data(Vector3(rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0)));
+		Transform3D transform_a = random_transform(rng, 0.5);
+		Transform3D transform_b = random_transform(rng, 4.0);
+
+		int contact_count = 0;
+		bool collided = GodotCollisionSolver3D::solve_static(&box_a, transform_a, &box_b, transform_b, count_contacts, &contact_count);
+
+		Vector3 closest_a;
+		Vector3 closest_b;
+		bool separated = gjk_epa_calculate_distance(&box_a, transform_a, &box_b, transform_b, closest_a, closest_b);
+		if (separated) {
+			if (closest_a.distance_to(closest_b) < 0.01) {
+				continue; // Touching, either answer is fine.
+			}
+			separated_count++;
+			//Reduce number of check messages
+			all_separated_agree &= !collided && contact_count == 0;
+		} else {
+			colliding_count++;
+			all_colliding_agree &= collided && contact_count > 0;
+		}
+	}
+
+	CHECK_MESSAGE(separated_count > 100, "The random pairs should include many separated boxes.");
+	CHECK_MESSAGE(colliding_count > 100, "The random pairs should include many colliding boxes.");
+	CHECK_MESSAGE(all_separated_agree, "Boxes found separated by GJK should not generate contacts.");
+	CHECK_MESSAGE(all_colliding_agree, "Boxes found penetrating by GJK should generate contacts.");
+}
+
+TEST_CASE("[Physics3D][CollisionSolver] Box-box contacts agree with a reference separating axis test") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(7);
+
+	GodotBoxShape3D box_a;
+	GodotBoxShape3D box_b;
+
+	int separated_count = 0;
+	int colliding_count = 0;
+	bool all_separated_agree = true;
+	bool all_colliding_agree = true;
+
+	for (int i = 0; i < 4000; i++) {
+		box_a.set_data(Vector3(rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0)));
+		box_b.set_data(Vector3(rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0), rng->randf_range(0.1, 2.0)));
+		Transform3D transform_a = random_transform(rng, 0.5);
+		Transform3D transform_b = random_transform(rng, 3.0);
+
+		const real_t overlap = reference_box_box_overlap(box_a.get_half_extents(), transform_a, box_b.get_half_extents(), transform_b);
+		if (Math::abs(overlap) < 0.01) {
+			continue; // Touching, either answer is fine.
+		}
+
+		LocalVector<Contact> contacts;
+		bool collided = sat_calculate_penetration(&box_a, transform_a, &box_b, transform_b, collect_contacts, &contacts);
+
+		if (overlap < 0.0) {
+			separated_count++;
+			//Reduce number of check messages
+			all_separated_agree &= !collided && contacts.is_empty();
+		} else {
+			colliding_count++;
+			bool agree = collided && !contacts.is_empty();
+			for (const Contact &contact : contacts) {
+				// No contact can be deeper than the smallest overlap.
+				agree &= contact.point_a.distance_to(contact.point_b) <= overlap + 0.01;
+			}
+			all_colliding_agree &= agree;
+		}
+	}
+
+	CHECK_MESSAGE(separated_count > 100, "The random pairs should include many separated boxes.");
+	CHECK_MESSAGE(colliding_count > 100, "The random pairs should include many colliding boxes.");
+	CHECK_MESSAGE(all_separated_agree, "Boxes separated on one of the 15 axes should not generate contacts.");
+	CHECK_MESSAGE(all_colliding_agree, "Boxes overlapping on all 15 axes should generate contacts no deeper than the smallest overlap.");
+}
+
+} // namespace TestGodotCollisionSolver3D
+
+#endif // TEST_GODOT_COLLISION_SOLVER_3D_H
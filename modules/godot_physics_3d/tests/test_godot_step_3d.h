@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_STEP_3D_H
+#define TEST_GODOT_STEP_3D_H
+
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotStep3D {
+
+// Drops a stack of boxes on a static floor and returns their heights after a few seconds.
+// Every contact is a constraint, so each step goes through setup, pre-solve and solve.
+// Uses the physics server the test runner creates for [SceneTree] tests.
+static LocalVector<real_t> simulate_box_stack(int p_boxes, int p_steps) {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10, 0.5, 10));
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+	server->body_set_space(floor, space);
+
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	for (int i = 0; i < p_boxes; i++) {
+		RID box = server->body_create();
+		server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		server->body_add_shape(box, box_shape);
+		server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.5 + i * 1.05, 0)));
+		server->body_set_space(box, space);
+		boxes.push_back(box);
+	}
+
+	for (int i = 0; i < p_steps; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	LocalVector<real_t> heights;
+	for (const RID &box : boxes) {
+		heights.push_back(Transform3D(server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.y);
+		server->free(box);
+	}
+	server->free(floor);
+	server->free(box_shape);
+	server->free(floor_shape);
+	server->free(space);
+
+	return heights;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Stacked boxes come to rest on each other") {
+	const LocalVector<real_t> heights = simulate_box_stack(4, 180);
+	REQUIRE(heights.size() == 4);
+
+	// Reduce number of check messages.
+	bool resting = true;
+	for (uint32_t i = 0; i < heights.size(); i++) {
+		resting = resting && Math::abs(heights[i] - (0.5 + i)) < 0.1;
+	}
+	CHECK_MESSAGE(resting, "Every box should rest on top of the one below, which requires constraints to be solved after they are set up.");
+}
+
+TEST_CASE("[SceneTree][Physics3D] Stepping a space gives the same result every time") {
+	const LocalVector<real_t> first = simulate_box_stack(4, 60);
+	const LocalVector<real_t> second = simulate_box_stack(4, 60);
+	REQUIRE(first.size() == second.size());
+
+	// Reduce number of check messages.
+	bool same = true;
+	for (uint32_t i = 0; i < first.size(); i++) {
+		same = same && Math::is_equal_approx(first[i], second[i]);
+	}
+	CHECK_MESSAGE(same, "Constraint stages should always run in the same order.");
+}
+
+static RID create_resting_box(PhysicsServer3D *p_server, RID p_space, RID p_shape, real_t p_x) {
+	RID box = p_server->body_create();
+	p_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+	p_server->body_add_shape(box, p_shape);
+	p_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(p_x, 0.5, 0)));
+	p_server->body_set_space(box, p_space);
+	return box;
+}
+
+static int step_and_count_islands(PhysicsServer3D *p_server, int p_steps) {
+	for (int i = 0; i < p_steps; i++) {
+		p_server->step(1.0 / 60.0);
+	}
+	return p_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
+}
+
+TEST_CASE("[SceneTree][Physics3D] Cached islands follow changes to bodies and constraints") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10, 0.5, 10));
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+	server->body_set_space(floor, space);
+
+	// Boxes far enough apart to only touch the floor, which doesn't connect islands.
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID box_a = create_resting_box(server, space, box_shape, -3);
+	RID box_b = create_resting_box(server, space, box_shape, 3);
+	CHECK(step_and_count_islands(server, 10) == 2);
+	CHECK_MESSAGE(step_and_count_islands(server, 10) == 2, "Unchanged islands should be reused.");
+
+	RID box_c = create_resting_box(server, space, box_shape, 0);
+	CHECK_MESSAGE(step_and_count_islands(server, 1) == 3, "Adding a body should regenerate the islands.");
+
+	server->body_set_state(box_c, PhysicsServer3D::BODY_STATE_SLEEPING, true);
+	CHECK_MESSAGE(step_and_count_islands(server, 1) == 2, "Sleeping bodies should leave their island.");
+
+	server->body_set_state(box_c, PhysicsServer3D::BODY_STATE_SLEEPING, false);
+	CHECK_MESSAGE(step_and_count_islands(server, 1) == 3, "Bodies which wake up should get their island back.");
+
+	RID joint = server->joint_create();
+	server->joint_make_pin(joint, box_a, Vector3(1.5, 0, 0), box_c, Vector3(-1.5, 0, 0));
+	CHECK_MESSAGE(step_and_count_islands(server, 1) == 2, "A joint should merge the islands of its bodies.");
+
+	server->free(joint);
+	CHECK_MESSAGE(step_and_count_islands(server, 1) == 3, "Removing a joint should split the islands again.");
+
+	server->free(box_b);
+	CHECK_MESSAGE(step_and_count_islands(server, 1) == 2, "Removing a body should regenerate the islands.");
+
+	server->free(box_c);
+	server->free(box_a);
+	server->free(floor);
+	server->free(box_shape);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+} // namespace TestGodotStep3D
+
+#endif // TEST_GODOT_STEP_3D_H
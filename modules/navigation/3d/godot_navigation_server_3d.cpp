@@ -1329,6 +1329,7 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 	int _new_pm_obstacle_count = 0;
+	int _new_pm_sync_polygon_count = 0;
 
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
@@ -1347,6 +1348,7 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
 		_new_pm_obstacle_count += active_maps[i]->get_pm_obstacle_count();
+		_new_pm_sync_polygon_count += active_maps[i]->get_pm_sync_polygon_count();
 
 		// Emit a signal if a map changed.
 		const uint32_t new_map_iteration_id = active_maps[i]->get_iteration_id();
@@ -1365,6 +1367,7 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+	pm_sync_polygon_count = _new_pm_sync_polygon_count;
 }
 
 void GodotNavigationServer3D::init() {
@@ -1466,6 +1469,26 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 	return r_query_result;
 }
 
+void GodotNavigationServer3D::_query_paths(const LocalVector<PathQueryParameters> &p_parameters, LocalVector<PathQueryResult> &r_results) const {
+	const uint32_t query_count = p_parameters.size();
+	if (query_count < 2) {
+		NavigationServer3D::_query_paths(p_parameters, r_results);
+		return;
+	}
+
+	// Each query takes its own search buffers from the map, so they can run on all worker threads at once.
+	PathQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.results = &r_results;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_query_path_batch_item, &batch, query_count, -1, true, SNAME("NavigationServer3DQueryPaths"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotNavigationServer3D::_query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) const {
+	(*p_batch->results)[p_index] = _query_path((*p_batch->parameters)[p_index]);
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1602,6 +1625,9 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_OBSTACLE_COUNT: {
 			return pm_obstacle_count;
 		} break;
+		case INFO_SYNC_POLYGON_COUNT: {
+			return pm_sync_polygon_count;
+		} break;
 	}
 
 	return 0;
@@ -96,6 +96,7 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	int pm_sync_polygon_count = 0;
 
 public:
 	GodotNavigationServer3D();
@@ -289,10 +290,18 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void _query_paths(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, LocalVector<NavigationUtilities::PathQueryResult> &r_results) const override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
+	struct PathQueryBatch {
+		const LocalVector<NavigationUtilities::PathQueryParameters> *parameters = nullptr;
+		LocalVector<NavigationUtilities::PathQueryResult> *results = nullptr;
+	};
+
+	void _query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) const;
+
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
 };
@@ -35,6 +35,7 @@
 #include "../nav_base.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
@@ -49,6 +50,502 @@
 		r_path_owners->push_back(poly->owner->get_owner_id()); \
 	}
 
+#define BVH_LEAF_POLYGON_MAX 4
+#define BVH_QUERY_STACK_SIZE 64
+
+struct PolygonCenterCmp {
+	const Vector3 *centers = nullptr;
+	int axis = 0;
+
+	bool operator()(uint32_t p_left, uint32_t p_right) const {
+		return centers[p_left].coord[axis] < centers[p_right].coord[axis];
+	}
+};
+
+static int32_t _bvh_build_node(gd::PolygonBVH &r_bvh, const LocalVector<AABB> &p_aabbs, const LocalVector<Vector3> &p_centers, uint32_t p_first, uint32_t p_count) {
+	int32_t node_index = r_bvh.nodes.size();
+	r_bvh.nodes.push_back(gd::PolygonBVHNode());
+	r_bvh.nodes[node_index].first = p_first;
+	r_bvh.nodes[node_index].count = p_count;
+
+	if (p_count <= BVH_LEAF_POLYGON_MAX) {
+		AABB aabb = p_aabbs[r_bvh.polygon_indices[p_first]];
+		for (uint32_t i = p_first + 1; i < p_first + p_count; i++) {
+			aabb.merge_with(p_aabbs[r_bvh.polygon_indices[i]]);
+		}
+		r_bvh.nodes[node_index].aabb = aabb;
+		return node_index;
+	}
+
+	Vector3 center_min = p_centers[r_bvh.polygon_indices[p_first]];
+	Vector3 center_max = center_min;
+	for (uint32_t i = p_first + 1; i < p_first + p_count; i++) {
+		const Vector3 &center = p_centers[r_bvh.polygon_indices[i]];
+		center_min = center_min.min(center);
+		center_max = center_max.max(center);
+	}
+
+	// Split at the median polygon along the axis where the polygons are the most spread out.
+	SortArray<uint32_t, PolygonCenterCmp> sorter;
+	sorter.compare.centers = p_centers.ptr();
+	sorter.compare.axis = (center_max - center_min).max_axis_index();
+	uint32_t half = p_count / 2;
+	sorter.nth_element(0, p_count, half, &r_bvh.polygon_indices[p_first]);
+
+	int32_t left = _bvh_build_node(r_bvh, p_aabbs, p_centers, p_first, half);
+	int32_t right = _bvh_build_node(r_bvh, p_aabbs, p_centers, p_first + half, p_count - half);
+	r_bvh.nodes[node_index].left = left;
+	r_bvh.nodes[node_index].right = right;
+	// The node bounds are merged from the children, instead of from all polygons below them.
+	r_bvh.nodes[node_index].aabb = r_bvh.nodes[left].aabb.merge(r_bvh.nodes[right].aabb);
+	return node_index;
+}
+
+static _FORCE_INLINE_ real_t _aabb_distance_squared(const AABB &p_a, const AABB &p_b) {
+	Vector3 gap = (p_a.position - p_b.get_end()).max(p_b.position - p_a.get_end()).maxf(0.0);
+	return gap.length_squared();
+}
+
+// Calls `p_visit` with the index of each polygon whose AABB is not farther than the returned squared distance
+// from `p_query_aabb`, nearest nodes first. `p_visit` returns the new squared distance bound, or a negative value to stop.
+template <typename F>
+static void _bvh_query(const gd::PolygonBVH &p_bvh, const AABB &p_query_aabb, real_t p_max_distance_squared, F p_visit) {
+	if (p_bvh.root < 0) {
+		return;
+	}
+
+	struct StackEntry {
+		int32_t node;
+		real_t distance_squared;
+	};
+
+	// The tree is built with median splits, so its depth is logarithmic in the polygon count.
+	StackEntry stack[BVH_QUERY_STACK_SIZE];
+	uint32_t stack_size = 0;
+	real_t max_distance_squared = p_max_distance_squared;
+
+	stack[stack_size++] = { p_bvh.root, _aabb_distance_squared(p_bvh.nodes[p_bvh.root].aabb, p_query_aabb) };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		if (entry.distance_squared > max_distance_squared) {
+			continue;
+		}
+
+		const gd::PolygonBVHNode &node = p_bvh.nodes[entry.node];
+		if (node.left < 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				max_distance_squared = p_visit(p_bvh.polygon_indices[i]);
+				if (max_distance_squared < 0.0) {
+					return;
+				}
+			}
+			continue;
+		}
+
+		ERR_FAIL_COND(stack_size + 2 > BVH_QUERY_STACK_SIZE);
+
+		real_t left_distance_squared = _aabb_distance_squared(p_bvh.nodes[node.left].aabb, p_query_aabb);
+		real_t right_distance_squared = _aabb_distance_squared(p_bvh.nodes[node.right].aabb, p_query_aabb);
+
+		// Push the farthest child first so the nearest one is visited first.
+		if (left_distance_squared < right_distance_squared) {
+			stack[stack_size++] = { node.right, right_distance_squared };
+			stack[stack_size++] = { node.left, left_distance_squared };
+		} else {
+			stack[stack_size++] = { node.left, left_distance_squared };
+			stack[stack_size++] = { node.right, right_distance_squared };
+		}
+	}
+}
+
+// Updates `r_distance_squared` and `r_closest_point` if a face of the polygon is closer to `p_point`.
+static bool _polygon_get_closest_face_point(const gd::Polygon &p_polygon, const Vector3 &p_point, real_t &r_distance_squared, Vector3 &r_closest_point) {
+	bool found = false;
+	for (uint32_t point_id = 2; point_id < p_polygon.points.size(); point_id++) {
+		const Face3 face(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
+		const Vector3 point = face.get_closest_point_to(p_point);
+		const real_t distance_squared = point.distance_squared_to(p_point);
+		if (distance_squared < r_distance_squared) {
+			r_distance_squared = distance_squared;
+			r_closest_point = point;
+			found = true;
+		}
+	}
+	return found;
+}
+
+template <typename F>
+static const gd::Polygon *_polygons_find_closest_polygon(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, real_t p_max_distance_squared, Vector3 &r_closest_point, const gd::PolygonBVH *p_bvh, F p_filter) {
+	const gd::Polygon *closest_polygon = nullptr;
+	real_t closest_distance_squared = p_max_distance_squared;
+
+	if (p_bvh) {
+		_bvh_query(*p_bvh, AABB(p_point, Vector3()), closest_distance_squared, [&](uint32_t p_polygon_index) -> real_t {
+			const gd::Polygon &polygon = p_polygons[p_polygon_index];
+			if (p_filter(polygon) && _polygon_get_closest_face_point(polygon, p_point, closest_distance_squared, r_closest_point)) {
+				closest_polygon = &polygon;
+			}
+			return closest_distance_squared;
+		});
+		return closest_polygon;
+	}
+
+	for (const gd::Polygon &polygon : p_polygons) {
+		if (p_filter(polygon) && _polygon_get_closest_face_point(polygon, p_point, closest_distance_squared, r_closest_point)) {
+			closest_polygon = &polygon;
+		}
+	}
+	return closest_polygon;
+}
+
+// Builds `r_bvh` over the polygons at `p_polygon_indices`, or over all polygons when it is null.
+static void _bvh_build(const LocalVector<gd::Polygon> &p_polygons, const uint32_t *p_polygon_indices, uint32_t p_polygon_count, gd::PolygonBVH &r_bvh) {
+	r_bvh.clear();
+
+	// The bounds are stored per position in the polygon set, so building the BVH of a few polygons stays cheap in a large map.
+	LocalVector<AABB> aabbs;
+	LocalVector<Vector3> centers;
+	aabbs.resize(p_polygon_count);
+	centers.resize(p_polygon_count);
+	r_bvh.polygon_indices.reserve(p_polygon_count);
+
+	for (uint32_t i = 0; i < p_polygon_count; i++) {
+		const gd::Polygon &polygon = p_polygons[p_polygon_indices ? p_polygon_indices[i] : i];
+		if (polygon.points.size() < 3) {
+			continue;
+		}
+		AABB aabb(polygon.points[0].pos, Vector3());
+		for (uint32_t point_id = 1; point_id < polygon.points.size(); point_id++) {
+			aabb.expand_to(polygon.points[point_id].pos);
+		}
+		aabbs[i] = aabb;
+		centers[i] = aabb.get_center();
+		r_bvh.polygon_indices.push_back(i);
+	}
+
+	if (r_bvh.polygon_indices.is_empty()) {
+		return;
+	}
+
+	r_bvh.nodes.reserve(2 * r_bvh.polygon_indices.size() / BVH_LEAF_POLYGON_MAX + 1);
+	r_bvh.root = _bvh_build_node(r_bvh, aabbs, centers, 0, r_bvh.polygon_indices.size());
+
+	if (p_polygon_indices) {
+		for (uint32_t &polygon_index : r_bvh.polygon_indices) {
+			polygon_index = p_polygon_indices[polygon_index];
+		}
+	}
+}
+
+// Appends the nodes of `p_bvh` to `r_bvh` and returns the index of its root there.
+static int32_t _bvh_append(gd::PolygonBVH &r_bvh, const gd::PolygonBVH &p_bvh) {
+	const int32_t node_offset = r_bvh.nodes.size();
+	const uint32_t index_offset = r_bvh.polygon_indices.size();
+
+	for (const gd::PolygonBVHNode &source_node : p_bvh.nodes) {
+		gd::PolygonBVHNode node = source_node;
+		if (node.left >= 0) {
+			node.left += node_offset;
+			node.right += node_offset;
+		}
+		node.first += index_offset;
+		r_bvh.nodes.push_back(node);
+	}
+	for (uint32_t polygon_index : p_bvh.polygon_indices) {
+		r_bvh.polygon_indices.push_back(polygon_index);
+	}
+
+	return p_bvh.root + node_offset;
+}
+
+static int32_t _bvh_merge_node(gd::PolygonBVH &r_bvh, const LocalVector<const gd::PolygonBVH *> &p_bvhs, const LocalVector<Vector3> &p_centers, uint32_t *p_order, uint32_t p_count) {
+	if (p_count == 1) {
+		return _bvh_append(r_bvh, *p_bvhs[p_order[0]]);
+	}
+
+	int32_t node_index = r_bvh.nodes.size();
+	r_bvh.nodes.push_back(gd::PolygonBVHNode());
+
+	Vector3 center_min = p_centers[p_order[0]];
+	Vector3 center_max = center_min;
+	for (uint32_t i = 1; i < p_count; i++) {
+		center_min = center_min.min(p_centers[p_order[i]]);
+		center_max = center_max.max(p_centers[p_order[i]]);
+	}
+
+	SortArray<uint32_t, PolygonCenterCmp> sorter;
+	sorter.compare.centers = p_centers.ptr();
+	sorter.compare.axis = (center_max - center_min).max_axis_index();
+	uint32_t half = p_count / 2;
+	sorter.nth_element(0, p_count, half, p_order);
+
+	// The subtrees are appended one after the other, so the polygons below this node stay a contiguous range.
+	int32_t left = _bvh_merge_node(r_bvh, p_bvhs, p_centers, p_order, half);
+	int32_t right = _bvh_merge_node(r_bvh, p_bvhs, p_centers, p_order + half, p_count - half);
+	r_bvh.nodes[node_index].left = left;
+	r_bvh.nodes[node_index].right = right;
+	r_bvh.nodes[node_index].first = r_bvh.nodes[left].first;
+	r_bvh.nodes[node_index].count = r_bvh.nodes[left].count + r_bvh.nodes[right].count;
+	r_bvh.nodes[node_index].aabb = r_bvh.nodes[left].aabb.merge(r_bvh.nodes[right].aabb);
+	return node_index;
+}
+
+void NavMeshQueries3D::polygons_build_bvh(const LocalVector<gd::Polygon> &p_polygons, gd::PolygonBVH &r_bvh) {
+	_bvh_build(p_polygons, nullptr, p_polygons.size(), r_bvh);
+}
+
+void NavMeshQueries3D::polygons_build_bvh(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<uint32_t> &p_polygon_indices, gd::PolygonBVH &r_bvh) {
+	_bvh_build(p_polygons, p_polygon_indices.ptr(), p_polygon_indices.size(), r_bvh);
+}
+
+void NavMeshQueries3D::polygons_merge_bvhs(const LocalVector<const gd::PolygonBVH *> &p_bvhs, gd::PolygonBVH &r_bvh) {
+	r_bvh.clear();
+
+	LocalVector<uint32_t> order;
+	LocalVector<Vector3> centers;
+	uint32_t node_count = 0;
+	uint32_t polygon_count = 0;
+	centers.resize(p_bvhs.size());
+	for (uint32_t i = 0; i < p_bvhs.size(); i++) {
+		const gd::PolygonBVH *bvh = p_bvhs[i];
+		if (bvh->root < 0) {
+			continue;
+		}
+		centers[i] = bvh->nodes[bvh->root].aabb.get_center();
+		order.push_back(i);
+		node_count += bvh->nodes.size() + 1;
+		polygon_count += bvh->polygon_indices.size();
+	}
+
+	if (order.is_empty()) {
+		return;
+	}
+
+	r_bvh.nodes.reserve(node_count);
+	r_bvh.polygon_indices.reserve(polygon_count);
+	r_bvh.root = _bvh_merge_node(r_bvh, p_bvhs, centers, order.ptr(), order.size());
+}
+
+void NavMeshQueries3D::polygons_build_clusters(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, const gd::PolygonBVH &p_bvh, uint32_t p_cluster_size, gd::PolygonClusters &r_clusters) {
+	r_clusters.clear();
+
+	if (p_bvh.root < 0) {
+		return;
+	}
+
+	const uint32_t polygon_count = p_polygons.size() + p_link_polygons.size();
+	r_clusters.polygon_clusters.resize(polygon_count);
+	for (uint32_t &cluster : r_clusters.polygon_clusters) {
+		cluster = UINT32_MAX;
+	}
+
+	// The BVH is built with median splits, so every subtree holds polygons that are close together.
+	// Group the polygons by the largest subtrees with at most `p_cluster_size` polygons.
+	LocalVector<uint32_t> polygon_groups;
+	polygon_groups.resize(polygon_count);
+	for (uint32_t &group : polygon_groups) {
+		group = UINT32_MAX;
+	}
+	uint32_t group_count = 0;
+	LocalVector<int32_t> node_stack;
+	node_stack.push_back(p_bvh.root);
+	while (!node_stack.is_empty()) {
+		const gd::PolygonBVHNode &node = p_bvh.nodes[node_stack[node_stack.size() - 1]];
+		node_stack.remove_at(node_stack.size() - 1);
+
+		if (node.left >= 0 && node.count > p_cluster_size) {
+			node_stack.push_back(node.left);
+			node_stack.push_back(node.right);
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			polygon_groups[p_polygons[p_bvh.polygon_indices[i]].id] = group_count;
+		}
+		group_count++;
+	}
+
+	// A group can be cut in pieces by walls or by polygons on other navigation layers. Split each group into the
+	// pieces that are connected through polygons with the same layers, so a path can cross any cluster it enters.
+	LocalVector<const gd::Polygon *> polygon_stack;
+	for (const gd::Polygon &seed : p_polygons) {
+		const uint32_t group = polygon_groups[seed.id];
+		if (group == UINT32_MAX || r_clusters.polygon_clusters[seed.id] != UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t cluster = r_clusters.cluster_centers.size();
+		const uint32_t navigation_layers = seed.owner->get_navigation_layers();
+		Vector3 center;
+		uint32_t cluster_polygon_count = 0;
+
+		r_clusters.polygon_clusters[seed.id] = cluster;
+		polygon_stack.push_back(&seed);
+		while (!polygon_stack.is_empty()) {
+			const gd::Polygon *polygon = polygon_stack[polygon_stack.size() - 1];
+			polygon_stack.remove_at(polygon_stack.size() - 1);
+
+			Vector3 polygon_center;
+			for (const gd::Point &point : polygon->points) {
+				polygon_center += point.pos;
+			}
+			center += polygon_center / polygon->points.size();
+			cluster_polygon_count++;
+
+			for (const gd::Edge &edge : polygon->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const gd::Polygon *neighbor = connection.polygon;
+					if (polygon_groups[neighbor->id] == group && r_clusters.polygon_clusters[neighbor->id] == UINT32_MAX &&
+							neighbor->owner->get_navigation_layers() == navigation_layers) {
+						r_clusters.polygon_clusters[neighbor->id] = cluster;
+						polygon_stack.push_back(neighbor);
+					}
+				}
+			}
+		}
+
+		r_clusters.cluster_centers.push_back(center / cluster_polygon_count);
+	}
+
+	// Link polygons and polygons that are not in the BVH become clusters of their own.
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		const gd::Polygon &polygon = i < p_polygons.size() ? p_polygons[i] : p_link_polygons[i - p_polygons.size()];
+		if (polygon.owner == nullptr || polygon.points.is_empty() || r_clusters.polygon_clusters[polygon.id] != UINT32_MAX) {
+			continue;
+		}
+		Vector3 center;
+		for (const gd::Point &point : polygon.points) {
+			center += point.pos;
+		}
+		r_clusters.polygon_clusters[polygon.id] = r_clusters.cluster_centers.size();
+		r_clusters.cluster_centers.push_back(center / polygon.points.size());
+	}
+
+	// Gather the cluster links from the polygon connections that cross cluster borders.
+	// A link costs the distance between the cluster centers, weighted with the cheapest travel cost of the polygons it enters.
+	HashMap<uint64_t, uint32_t> link_indices;
+	LocalVector<uint32_t> link_sources;
+	LocalVector<gd::ClusterLink> links;
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		const gd::Polygon &polygon = i < p_polygons.size() ? p_polygons[i] : p_link_polygons[i - p_polygons.size()];
+		if (polygon.owner == nullptr) {
+			continue;
+		}
+		const uint32_t from_cluster = r_clusters.polygon_clusters[polygon.id];
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t to_cluster = r_clusters.polygon_clusters[connection.polygon->id];
+				if (from_cluster == UINT32_MAX || to_cluster == UINT32_MAX || from_cluster == to_cluster) {
+					continue;
+				}
+
+				const uint64_t key = ((uint64_t)from_cluster << 32) | to_cluster;
+				const real_t cost = r_clusters.cluster_centers[from_cluster].distance_to(r_clusters.cluster_centers[to_cluster]) * connection.polygon->owner->get_travel_cost();
+				HashMap<uint64_t, uint32_t>::Iterator E = link_indices.find(key);
+				if (E) {
+					gd::ClusterLink &link = links[E->value];
+					link.navigation_layers |= connection.polygon->owner->get_navigation_layers();
+					link.cost = MIN(link.cost, cost);
+				} else {
+					gd::ClusterLink link;
+					link.cluster = to_cluster;
+					link.navigation_layers = connection.polygon->owner->get_navigation_layers();
+					link.cost = cost;
+					link_indices.insert(key, links.size());
+					link_sources.push_back(from_cluster);
+					links.push_back(link);
+				}
+			}
+		}
+	}
+
+	// Store the links grouped by source cluster.
+	const uint32_t cluster_count = r_clusters.cluster_centers.size();
+	r_clusters.cluster_link_offsets.resize(cluster_count + 1);
+	for (uint32_t &offset : r_clusters.cluster_link_offsets) {
+		offset = 0;
+	}
+	for (uint32_t source : link_sources) {
+		r_clusters.cluster_link_offsets[source + 1]++;
+	}
+	for (uint32_t i = 0; i < cluster_count; i++) {
+		r_clusters.cluster_link_offsets[i + 1] += r_clusters.cluster_link_offsets[i];
+	}
+	LocalVector<uint32_t> link_counts;
+	link_counts.resize(cluster_count);
+	for (uint32_t &count : link_counts) {
+		count = 0;
+	}
+	r_clusters.cluster_links.resize(links.size());
+	for (uint32_t i = 0; i < links.size(); i++) {
+		const uint32_t source = link_sources[i];
+		r_clusters.cluster_links[r_clusters.cluster_link_offsets[source] + link_counts[source]++] = links[i];
+	}
+}
+
+// Runs A* over the clusters and marks the clusters along the found route, and their neighbors, as the corridor
+// that the polygon search may enter. Returns false if the clusters are not connected for the given layers.
+static bool _clusters_build_corridor(const gd::PolygonClusters &p_clusters, uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_end_point, uint32_t p_navigation_layers, gd::PathQuerySlot &r_slot) {
+	const uint32_t cluster_count = p_clusters.cluster_centers.size();
+	r_slot.cluster_traveled_distances.resize(cluster_count);
+	r_slot.cluster_back_ids.resize(cluster_count);
+	for (uint32_t i = 0; i < cluster_count; i++) {
+		r_slot.cluster_traveled_distances[i] = FLT_MAX;
+		r_slot.cluster_back_ids[i] = -1;
+	}
+
+	gd::Heap<gd::ClusterQueueEntry, gd::ClusterQueueEntryGreaterThan> &traversable_clusters = r_slot.traversable_clusters;
+	traversable_clusters.clear();
+
+	r_slot.cluster_traveled_distances[p_begin_cluster] = 0.0;
+	traversable_clusters.push({ p_clusters.cluster_centers[p_begin_cluster].distance_to(p_end_point), 0.0, p_begin_cluster });
+
+	bool found_route = false;
+	while (!traversable_clusters.is_empty()) {
+		const gd::ClusterQueueEntry entry = traversable_clusters.pop();
+		if (entry.cluster == p_end_cluster) {
+			found_route = true;
+			break;
+		}
+		// Clusters are pushed again when a shorter route is found, skip the outdated entries.
+		if (entry.traveled_distance > r_slot.cluster_traveled_distances[entry.cluster]) {
+			continue;
+		}
+
+		for (uint32_t i = p_clusters.cluster_link_offsets[entry.cluster]; i < p_clusters.cluster_link_offsets[entry.cluster + 1]; i++) {
+			const gd::ClusterLink &link = p_clusters.cluster_links[i];
+			if ((p_navigation_layers & link.navigation_layers) == 0) {
+				continue;
+			}
+			const real_t traveled_distance = entry.traveled_distance + link.cost;
+			if (traveled_distance < r_slot.cluster_traveled_distances[link.cluster]) {
+				r_slot.cluster_traveled_distances[link.cluster] = traveled_distance;
+				r_slot.cluster_back_ids[link.cluster] = entry.cluster;
+				traversable_clusters.push({ traveled_distance + p_clusters.cluster_centers[link.cluster].distance_to(p_end_point), traveled_distance, link.cluster });
+			}
+		}
+	}
+
+	if (!found_route) {
+		return false;
+	}
+
+	r_slot.cluster_corridor.resize(cluster_count);
+	for (uint8_t &in_corridor : r_slot.cluster_corridor) {
+		in_corridor = 0;
+	}
+	for (int32_t cluster = p_end_cluster; cluster != -1; cluster = r_slot.cluster_back_ids[cluster]) {
+		r_slot.cluster_corridor[cluster] = 1;
+		// Widen the corridor so the polygon search can cut corners the coarse route doesn't know about.
+		for (uint32_t i = p_clusters.cluster_link_offsets[cluster]; i < p_clusters.cluster_link_offsets[cluster + 1]; i++) {
+			r_slot.cluster_corridor[p_clusters.cluster_links[i].cluster] = 1;
+		}
+	}
+
+	return true;
+}
+
 Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly) {
 	const LocalVector<gd::Polygon> &region_polygons = p_polygons;
 
@@ -58,7 +555,10 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 
 	if (p_uniformly) {
 		real_t accumulated_area = 0;
-		RBMap<real_t, uint32_t> region_area_map;
+		LocalVector<real_t> region_area_starts;
+		LocalVector<uint32_t> region_area_indices;
+		region_area_starts.reserve(region_polygons.size());
+		region_area_indices.reserve(region_polygons.size());
 
 		for (uint32_t rp_index = 0; rp_index < region_polygons.size(); rp_index++) {
 			const gd::Polygon &region_polygon = region_polygons[rp_index];
@@ -67,19 +567,29 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 			if (polyon_area == 0.0) {
 				continue;
 			}
-			region_area_map[accumulated_area] = rp_index;
+			region_area_starts.push_back(accumulated_area);
+			region_area_indices.push_back(rp_index);
 			accumulated_area += polyon_area;
 		}
-		if (region_area_map.is_empty() || accumulated_area == 0) {
+		if (region_area_starts.is_empty() || accumulated_area == 0) {
 			// All polygons have no real surface / no area.
 			return Vector3();
 		}
 
 		real_t region_area_map_pos = Math::random(real_t(0), accumulated_area);
 
-		RBMap<real_t, uint32_t>::Iterator region_E = region_area_map.find_closest(region_area_map_pos);
-		ERR_FAIL_COND_V(!region_E, Vector3());
-		uint32_t rrp_polygon_index = region_E->value;
+		// Binary search the last polygon whose accumulated area starts before the random position.
+		uint32_t area_begin = 0;
+		uint32_t area_end = region_area_starts.size();
+		while (area_end - area_begin > 1) {
+			uint32_t area_middle = (area_begin + area_end) / 2;
+			if (region_area_starts[area_middle] <= region_area_map_pos) {
+				area_begin = area_middle;
+			} else {
+				area_end = area_middle;
+			}
+		}
+		uint32_t rrp_polygon_index = region_area_indices[area_begin];
 		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector3());
 
 		const gd::Polygon &rr_polygon = region_polygons[rrp_polygon_index];
@@ -127,7 +637,7 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 	}
 }
 
-Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size) {
+Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const gd::PolygonBVH *p_bvh, gd::PathQuerySlot *p_slot, const gd::PolygonClusters *p_clusters) {
 	// Clear metadata outputs.
 	if (r_path_types) {
 		r_path_types->clear();
@@ -144,36 +654,15 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : p_polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	// Find the initial poly and the end poly on this map.
+	// Only consider the polygons in a region with compatible layers.
+	auto layers_filter = [p_navigation_layers](const gd::Polygon &p_polygon) {
+		return (p_navigation_layers & p_polygon.owner->get_navigation_layers()) != 0;
+	};
+	begin_poly = _polygons_find_closest_polygon(p_polygons, p_origin, FLT_MAX, begin_point, p_bvh, layers_filter);
+	end_poly = _polygons_find_closest_polygon(p_polygons, p_destination, FLT_MAX, end_point, p_bvh, layers_filter);
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -205,21 +694,53 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		return path;
 	}
 
+	// Reuse the search buffers of the slot when one is given, this avoids
+	// allocating and clearing an array of all map polygons for each query.
+	gd::PathQuerySlot local_slot;
+	gd::PathQuerySlot &query_slot = p_slot ? *p_slot : local_slot;
+	query_slot.expanded_polygon_count = 0;
+
+	// Heap of polygons to travel next.
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> &traversable_polys = query_slot.traversable_polys;
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.resize(p_polygons.size() + p_link_polygons_size);
+	LocalVector<gd::NavigationPoly> &navigation_polys = query_slot.navigation_polys;
+	LocalVector<uint32_t> &touched_polys = query_slot.touched_polys;
 
-	// Initialize the matching navigation polygon.
-	gd::NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
-	begin_navigation_poly.poly = begin_poly;
-	begin_navigation_poly.entry = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
+	auto begin_search = [&]() {
+		// The heap points into the navigation polys, clear it before they are reset or resized.
+		traversable_polys.clear();
 
-	// Heap of polygons to travel next.
-	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer>
-			traversable_polys;
-	traversable_polys.reserve(p_polygons.size() * 0.25);
+		// Only the entries touched by the previous search need to be reset.
+		for (uint32_t touched_id : touched_polys) {
+			if (touched_id < navigation_polys.size()) {
+				navigation_polys[touched_id] = gd::NavigationPoly();
+			}
+		}
+		touched_polys.clear();
+		navigation_polys.resize(p_polygons.size() + p_link_polygons_size);
+		traversable_polys.reserve(p_polygons.size() * 0.25);
+
+		// Initialize the matching navigation polygon.
+		gd::NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
+		begin_navigation_poly.poly = begin_poly;
+		begin_navigation_poly.entry = begin_point;
+		begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
+		begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
+		touched_polys.push_back(begin_poly->id);
+	};
+	begin_search();
+
+	// When the map is split in clusters, search the cluster graph first and only let the
+	// polygon search enter the clusters along the coarse route.
+	bool use_corridor = false;
+	if (p_clusters && !p_clusters->is_empty()) {
+		const uint32_t begin_cluster = p_clusters->polygon_clusters[begin_poly->id];
+		const uint32_t end_cluster = p_clusters->polygon_clusters[end_poly->id];
+		if (begin_cluster != end_cluster && begin_cluster != UINT32_MAX && end_cluster != UINT32_MAX) {
+			use_corridor = _clusters_build_corridor(*p_clusters, begin_cluster, end_cluster, end_point, p_navigation_layers, query_slot);
+		}
+	}
 
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = begin_poly->id;
@@ -231,6 +752,8 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	bool is_reachable = true;
 
 	while (true) {
+		query_slot.expanded_polygon_count++;
+
 		// Takes the current least_cost_poly neighbors (iterating over its edges) and compute the traveled_distance.
 		for (const gd::Edge &edge : navigation_polys[least_cost_id].poly->edges) {
 			// Iterate over connections in this edge, then compute the new optimized travel distance assigned to this polygon.
@@ -242,6 +765,13 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 					continue;
 				}
 
+				if (use_corridor) {
+					const uint32_t cluster = p_clusters->polygon_clusters[connection.polygon->id];
+					if (cluster != UINT32_MAX && !query_slot.cluster_corridor[cluster]) {
+						continue;
+					}
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -290,6 +820,7 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 
 					// Add the polygon to the heap of polygons to traverse next.
 					traversable_polys.push(&neighbor_poly);
+					touched_polys.push_back(connection.polygon->id);
 				}
 			}
 		}
@@ -297,6 +828,17 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
+			if (use_corridor) {
+				// The end polygon can't be reached inside the corridor, search the whole map instead.
+				use_corridor = false;
+				begin_search();
+				least_cost_id = begin_poly->id;
+				prev_least_cost_id = -1;
+				reachable_end = nullptr;
+				distance_to_reachable_end = FLT_MAX;
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -358,8 +900,8 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 				return path;
 			}
 
-			for (gd::NavigationPoly &nav_poly : navigation_polys) {
-				nav_poly.poly = nullptr;
+			for (uint32_t touched_id : touched_polys) {
+				navigation_polys[touched_id].poly = nullptr;
 			}
 			navigation_polys[begin_poly->id].poly = begin_poly;
 
@@ -579,155 +1121,217 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	return path;
 }
 
-Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
-	bool use_collision = p_use_collision;
+// Updates `r_distance` and `r_closest_point` if a face of the polygon is crossed by the segment closer to `p_from`.
+static bool _polygon_intersect_segment(const gd::Polygon &p_polygon, const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_closest_point) {
+	bool found = false;
+	for (uint32_t point_id = 2; point_id < p_polygon.points.size(); point_id += 1) {
+		const Face3 face(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
+		Vector3 intersection_point;
+		if (face.intersects_segment(p_from, p_to, &intersection_point)) {
+			const real_t d = p_from.distance_to(intersection_point);
+			if (d < r_distance) {
+				r_closest_point = intersection_point;
+				r_distance = d;
+				found = true;
+			}
+		}
+	}
+	return found;
+}
+
+// Updates `r_distance` and `r_closest_point` with the closest point of the polygon to the segment, for a segment that doesn't cross it.
+static void _polygon_get_closest_point_to_segment(const gd::Polygon &p_polygon, const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_closest_point) {
+	// For each face check the distance from segment's endpoints.
+	for (uint32_t point_id = 2; point_id < p_polygon.points.size(); point_id += 1) {
+		const Face3 face(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
+
+		const Vector3 p_from_closest = face.get_closest_point_to(p_from);
+		const real_t d_p_from = p_from.distance_to(p_from_closest);
+		if (r_distance > d_p_from) {
+			r_closest_point = p_from_closest;
+			r_distance = d_p_from;
+		}
+
+		const Vector3 p_to_closest = face.get_closest_point_to(p_to);
+		const real_t d_p_to = p_to.distance_to(p_to_closest);
+		if (r_distance > d_p_to) {
+			r_closest_point = p_to_closest;
+			r_distance = d_p_to;
+		}
+	}
+
+	// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
+	for (uint32_t point_id = 0; point_id < p_polygon.points.size(); point_id += 1) {
+		Vector3 a, b;
+
+		Geometry3D::get_closest_points_between_segments(
+				p_from,
+				p_to,
+				p_polygon.points[point_id].pos,
+				p_polygon.points[(point_id + 1) % p_polygon.points.size()].pos,
+				a,
+				b);
+
+		const real_t d = a.distance_to(b);
+		if (d < r_distance) {
+			r_distance = d;
+			r_closest_point = b;
+		}
+	}
+}
+
+Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision, const gd::PolygonBVH *p_bvh) {
 	Vector3 closest_point;
 	real_t closest_point_distance = FLT_MAX;
 
-	for (const gd::Polygon &polygon : p_polygons) {
-		// For each face check the distance to the segment.
-		for (size_t point_id = 2; point_id < polygon.points.size(); point_id += 1) {
-			const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
-			Vector3 intersection_point;
-			if (face.intersects_segment(p_from, p_to, &intersection_point)) {
-				const real_t d = p_from.distance_to(intersection_point);
-				if (!use_collision) {
-					closest_point = intersection_point;
-					use_collision = true;
-					closest_point_distance = d;
-				} else if (closest_point_distance > d) {
-					closest_point = intersection_point;
-					closest_point_distance = d;
-				}
-			}
-			// If segment does not itersect face, check the distance from segment's endpoints.
-			else if (!use_collision) {
-				const Vector3 p_from_closest = face.get_closest_point_to(p_from);
-				const real_t d_p_from = p_from.distance_to(p_from_closest);
-				if (closest_point_distance > d_p_from) {
-					closest_point = p_from_closest;
-					closest_point_distance = d_p_from;
-				}
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
 
-				const Vector3 p_to_closest = face.get_closest_point_to(p_to);
-				const real_t d_p_to = p_to.distance_to(p_to_closest);
-				if (closest_point_distance > d_p_to) {
-					closest_point = p_to_closest;
-					closest_point_distance = d_p_to;
-				}
-			}
+	// A face crossed by the segment always wins, the one closest to the segment start.
+	bool intersects = false;
+	if (p_bvh) {
+		_bvh_query(*p_bvh, segment_aabb, 0.0, [&](uint32_t p_polygon_index) -> real_t {
+			intersects |= _polygon_intersect_segment(p_polygons[p_polygon_index], p_from, p_to, closest_point_distance, closest_point);
+			return 0.0;
+		});
+	} else {
+		for (const gd::Polygon &polygon : p_polygons) {
+			intersects |= _polygon_intersect_segment(polygon, p_from, p_to, closest_point_distance, closest_point);
 		}
-		// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-		if (!use_collision) {
-			for (size_t point_id = 0; point_id < polygon.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						polygon.points[point_id].pos,
-						polygon.points[(point_id + 1) % polygon.points.size()].pos,
-						a,
-						b);
-
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_distance) {
-					closest_point_distance = d;
-					closest_point = b;
-				}
-			}
+	}
+
+	if (intersects || p_use_collision) {
+		return closest_point;
+	}
+
+	if (p_bvh) {
+		_bvh_query(*p_bvh, segment_aabb, FLT_MAX, [&](uint32_t p_polygon_index) -> real_t {
+			_polygon_get_closest_point_to_segment(p_polygons[p_polygon_index], p_from, p_to, closest_point_distance, closest_point);
+			return closest_point_distance < FLT_MAX ? closest_point_distance * closest_point_distance : FLT_MAX;
+		});
+	} else {
+		for (const gd::Polygon &polygon : p_polygons) {
+			_polygon_get_closest_point_to_segment(polygon, p_from, p_to, closest_point_distance, closest_point);
 		}
 	}
 
 	return closest_point;
 }
 
-Vector3 NavMeshQueries3D::polygons_get_closest_point(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
-	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
+Vector3 NavMeshQueries3D::polygons_get_closest_point(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh) {
+	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point, p_bvh);
 	return cp.point;
 }
 
-Vector3 NavMeshQueries3D::polygons_get_closest_point_normal(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
-	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
+Vector3 NavMeshQueries3D::polygons_get_closest_point_normal(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh) {
+	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point, p_bvh);
 	return cp.normal;
 }
 
-gd::ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
-	gd::ClosestPointQueryResult result;
-	real_t closest_point_distance_squared = FLT_MAX;
-
-	for (const gd::Polygon &polygon : p_polygons) {
-		Vector3 plane_normal = (polygon.points[1].pos - polygon.points[0].pos).cross(polygon.points[2].pos - polygon.points[0].pos);
-		Vector3 closest_on_polygon;
-		real_t closest = FLT_MAX;
-		bool inside = true;
-		Vector3 previous = polygon.points[polygon.points.size() - 1].pos;
-		for (size_t point_id = 0; point_id < polygon.points.size(); ++point_id) {
-			Vector3 edge = polygon.points[point_id].pos - previous;
-			Vector3 to_point = p_point - previous;
-			Vector3 edge_to_point_pormal = edge.cross(to_point);
-			bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-			// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-			if (!clockwise) {
-				inside = false;
-				real_t point_projected_on_edge = edge.dot(to_point);
-				real_t edge_square = edge.length_squared();
-
-				if (point_projected_on_edge > edge_square) {
-					real_t distance = polygon.points[point_id].pos.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = polygon.points[point_id].pos;
-						closest = distance;
-					}
-				} else if (point_projected_on_edge < 0.f) {
-					real_t distance = previous.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = previous;
-						closest = distance;
-					}
-				} else {
-					// If we project on this edge, this will be the closest point.
-					real_t percent = point_projected_on_edge / edge_square;
-					closest_on_polygon = previous + percent * edge;
-					break;
+// Updates `r_result` if the polygon is closer to `p_point`. Returns `true` when the point lies on the polygon,
+// as nothing can be closer.
+static bool _polygon_get_closest_point_info(const gd::Polygon &p_polygon, const Vector3 &p_point, real_t &r_distance_squared, gd::ClosestPointQueryResult &r_result) {
+	const gd::Polygon &polygon = p_polygon;
+
+	Vector3 plane_normal = (polygon.points[1].pos - polygon.points[0].pos).cross(polygon.points[2].pos - polygon.points[0].pos);
+	Vector3 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector3 previous = polygon.points[polygon.points.size() - 1].pos;
+	for (size_t point_id = 0; point_id < polygon.points.size(); ++point_id) {
+		Vector3 edge = polygon.points[point_id].pos - previous;
+		Vector3 to_point = p_point - previous;
+		Vector3 edge_to_point_pormal = edge.cross(to_point);
+		bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = polygon.points[point_id].pos.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = polygon.points[point_id].pos;
+					closest = distance;
 				}
+			} else if (point_projected_on_edge < 0.f) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
 			}
-			previous = polygon.points[point_id].pos;
 		}
+		previous = polygon.points[point_id].pos;
+	}
 
-		if (inside) {
-			Vector3 plane_normalized = plane_normal.normalized();
-			real_t distance = plane_normalized.dot(p_point - polygon.points[0].pos);
-			real_t distance_squared = distance * distance;
-			if (distance_squared < closest_point_distance_squared) {
-				closest_point_distance_squared = distance_squared;
-				result.point = p_point - plane_normalized * distance;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
-
-				if (Math::is_zero_approx(distance)) {
-					break;
-				}
+	if (inside) {
+		Vector3 plane_normalized = plane_normal.normalized();
+		real_t distance = plane_normalized.dot(p_point - polygon.points[0].pos);
+		real_t distance_squared = distance * distance;
+		if (distance_squared < r_distance_squared) {
+			r_distance_squared = distance_squared;
+			r_result.point = p_point - plane_normalized * distance;
+			r_result.normal = plane_normal;
+			r_result.owner = polygon.owner->get_self();
+
+			if (Math::is_zero_approx(distance)) {
+				return true;
 			}
-		} else {
-			real_t distance = closest_on_polygon.distance_squared_to(p_point);
-			if (distance < closest_point_distance_squared) {
-				closest_point_distance_squared = distance;
-				result.point = closest_on_polygon;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
+		}
+	} else {
+		real_t distance = closest_on_polygon.distance_squared_to(p_point);
+		if (distance < r_distance_squared) {
+			r_distance_squared = distance;
+			r_result.point = closest_on_polygon;
+			r_result.normal = plane_normal;
+			r_result.owner = polygon.owner->get_self();
+		}
+	}
+
+	return false;
+}
+
+gd::ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh) {
+	gd::ClosestPointQueryResult result;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	if (p_bvh) {
+		_bvh_query(*p_bvh, AABB(p_point, Vector3()), closest_point_distance_squared, [&](uint32_t p_polygon_index) -> real_t {
+			if (_polygon_get_closest_point_info(p_polygons[p_polygon_index], p_point, closest_point_distance_squared, result)) {
+				return -1.0;
 			}
+			return closest_point_distance_squared;
+		});
+		return result;
+	}
+
+	for (const gd::Polygon &polygon : p_polygons) {
+		if (_polygon_get_closest_point_info(polygon, p_point, closest_point_distance_squared, result)) {
+			break;
 		}
 	}
 
 	return result;
 }
 
-RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
-	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
+RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh) {
+	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point, p_bvh);
 	return cp.owner;
 }
 
+const gd::Polygon *NavMeshQueries3D::polygons_get_closest_polygon_in_radius(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, real_t p_radius, Vector3 &r_closest_point, const gd::PolygonBVH *p_bvh) {
+	return _polygons_find_closest_polygon(p_polygons, p_point, p_radius * p_radius, r_closest_point, p_bvh, [](const gd::Polygon &p_polygon) {
+		return true;
+	});
+}
+
 void NavMeshQueries3D::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up) {
 	Vector3 from = path[path.size() - 1];
 
@@ -33,18 +33,32 @@
 
 #ifndef _3D_DISABLED
 
-#include "../nav_map.h"
+#include "../nav_utils.h"
+
+#include "core/variant/typed_array.h"
 
 class NavMeshQueries3D {
 public:
 	static Vector3 polygons_get_random_point(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
 
-	static Vector<Vector3> polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size);
-	static Vector3 polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision);
-	static Vector3 polygons_get_closest_point(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
-	static Vector3 polygons_get_closest_point_normal(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
-	static gd::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
-	static RID polygons_get_closest_point_owner(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
+	// When a BVH built with `polygons_build_bvh` is given, the queries only test the polygons near the query
+	// instead of scanning all of them. The results are the same, except for which polygon wins exact ties.
+	static void polygons_build_bvh(const LocalVector<gd::Polygon> &p_polygons, gd::PolygonBVH &r_bvh);
+	static void polygons_build_bvh(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<uint32_t> &p_polygon_indices, gd::PolygonBVH &r_bvh);
+	// Combines BVHs built over disjoint polygon sets of the same polygon array into one BVH over all of them.
+	static void polygons_merge_bvhs(const LocalVector<const gd::PolygonBVH *> &p_bvhs, gd::PolygonBVH &r_bvh);
+	// Splits the map polygons, and the link polygons, into clusters of about `p_cluster_size` neighboring polygons.
+	// When given to `polygons_get_path`, long paths are first searched on the cluster graph and the polygon search
+	// then only expands the polygons inside the found corridor. Paths are no longer guaranteed to be the shortest.
+	static void polygons_build_clusters(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, const gd::PolygonBVH &p_bvh, uint32_t p_cluster_size, gd::PolygonClusters &r_clusters);
+
+	static Vector<Vector3> polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const gd::PolygonBVH *p_bvh = nullptr, gd::PathQuerySlot *p_slot = nullptr, const gd::PolygonClusters *p_clusters = nullptr);
+	static Vector3 polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision, const gd::PolygonBVH *p_bvh = nullptr);
+	static Vector3 polygons_get_closest_point(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh = nullptr);
+	static Vector3 polygons_get_closest_point_normal(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh = nullptr);
+	static gd::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh = nullptr);
+	static RID polygons_get_closest_point_owner(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const gd::PolygonBVH *p_bvh = nullptr);
+	static const gd::Polygon *polygons_get_closest_polygon_in_radius(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, real_t p_radius, Vector3 &r_closest_point, const gd::PolygonBVH *p_bvh = nullptr);
 
 	static void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up);
 };
@@ -51,6 +51,9 @@
 #define NAVMAP_ITERATION_ZERO_ERROR_MSG()
 #endif // DEBUG_ENABLED
 
+#define NAVMAP_EDGE_MERGE_ERROR_MSG() \
+	ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.")
+
 void NavMap::set_up(Vector3 p_up) {
 	if (up == p_up) {
 		return;
@@ -91,6 +94,7 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 		return;
 	}
 	use_edge_connections = p_enabled;
+	all_regions_dirty = true;
 	iteration_dirty = true;
 }
 
@@ -99,6 +103,7 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 		return;
 	}
 	edge_connection_margin = p_edge_connection_margin;
+	all_regions_dirty = true;
 	iteration_dirty = true;
 }
 
@@ -130,9 +135,30 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return Vector<Vector3>();
 	}
 
-	return NavMeshQueries3D::polygons_get_path(
+	gd::PathQuerySlot *query_slot = _acquire_path_query_slot();
+	Vector<Vector3> path = NavMeshQueries3D::polygons_get_path(
 			polygons, p_origin, p_destination, p_optimize, p_navigation_layers,
-			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size());
+			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size(), &polygons_bvh, query_slot,
+			use_hierarchical_pathfinding ? &polygon_clusters : nullptr);
+	_release_path_query_slot(query_slot);
+
+	return path;
+}
+
+gd::PathQuerySlot *NavMap::_acquire_path_query_slot() const {
+	MutexLock lock(path_query_slots_mutex);
+	if (free_path_query_slots.is_empty()) {
+		// The pool grows to the number of path queries that ran concurrently on this map.
+		return memnew(gd::PathQuerySlot);
+	}
+	gd::PathQuerySlot *slot = free_path_query_slots[free_path_query_slots.size() - 1];
+	free_path_query_slots.remove_at(free_path_query_slots.size() - 1);
+	return slot;
+}
+
+void NavMap::_release_path_query_slot(gd::PathQuerySlot *p_slot) const {
+	MutexLock lock(path_query_slots_mutex);
+	free_path_query_slots.push_back(p_slot);
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -142,7 +168,7 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, p_from, p_to, p_use_collision);
+	return NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, p_from, p_to, p_use_collision, &polygons_bvh);
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
@@ -152,7 +178,7 @@ Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point(polygons, p_point, &polygons_bvh);
 }
 
 Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
@@ -162,7 +188,7 @@ Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_normal(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_normal(polygons, p_point, &polygons_bvh);
 }
 
 RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
@@ -172,17 +198,20 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 		return RID();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_owner(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_owner(polygons, p_point, &polygons_bvh);
 }
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	RWLockRead read_lock(map_rwlock);
 
-	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, p_point, &polygons_bvh);
 }
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
+	if (!dirty_regions.has(p_region)) {
+		dirty_regions.push_back(p_region);
+	}
 	iteration_dirty = true;
 }
 
@@ -190,6 +219,8 @@ void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
+		dirty_regions.erase(p_region);
+		removed_regions.push_back(p_region);
 		iteration_dirty = true;
 	}
 }
@@ -363,288 +394,476 @@ void NavMap::sync() {
 
 	_sync_dirty_map_update_requests();
 
+	performance_data.pm_sync_polygon_count = 0;
+
 	if (iteration_dirty) {
-		performance_data.pm_polygon_count = 0;
-		performance_data.pm_edge_count = 0;
-		performance_data.pm_edge_merge_count = 0;
-		performance_data.pm_edge_connection_count = 0;
-		performance_data.pm_edge_free_count = 0;
-
-		// Remove regions connections.
-		region_external_connections.clear();
-		for (NavRegion *region : regions) {
-			region_external_connections[region] = LocalVector<gd::Edge::Connection>();
+		_sync_regions();
+		_sync_links();
+
+		if (use_hierarchical_pathfinding) {
+			NavMeshQueries3D::polygons_build_clusters(polygons, link_polygons, polygons_bvh, hierarchical_cluster_size, polygon_clusters);
 		}
 
-		// Resize the polygon count.
-		int polygon_count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
+		iteration_id = iteration_id % UINT32_MAX + 1;
+	}
+
+	map_settings_dirty = false;
+	iteration_dirty = false;
+
+	_sync_avoidance();
+}
+
+void NavMap::_sync_regions() {
+	// Links connect to the map polygons again once the regions are synced.
+	for (uint32_t slot : link_connected_polygons) {
+		LocalVector<gd::Edge::Connection> &connections = polygons[slot].edges[0].connections;
+		for (uint32_t i = connections.size(); i > 0; i--) {
+			// Only the connections into link polygons have no edge.
+			if (connections[i - 1].edge == -1) {
+				connections.remove_at(i - 1);
 			}
-			polygon_count += region->get_polygons().size();
 		}
-		polygons.resize(polygon_count);
+	}
+	link_connected_polygons.clear();
+
+	uint32_t added_polygon_count = 0;
+	uint32_t removed_polygon_count = 0;
+	for (NavRegion *region : removed_regions) {
+		HashMap<NavRegion *, RegionSyncData>::Iterator data_it = region_sync_data.find(region);
+		if (data_it) {
+			removed_polygon_count += data_it->value.polygon_slots.size();
+		}
+	}
+	for (NavRegion *region : dirty_regions) {
+		HashMap<NavRegion *, RegionSyncData>::Iterator data_it = region_sync_data.find(region);
+		if (data_it) {
+			removed_polygon_count += data_it->value.polygon_slots.size();
+		}
+		if (region->get_enabled()) {
+			added_polygon_count += region->get_polygons().size();
+		}
+	}
+
+	const uint32_t kept_polygon_count = polygons.size() - free_polygon_slots.size() - removed_polygon_count;
 
-		// Copy all region polygons in the map.
-		polygon_count = 0;
+	// Moving the polygons in memory would break the connections of all of them, so everything is rebuilt
+	// when the new polygons do not fit in the current storage. The same goes when most slots are unused.
+	if (all_regions_dirty ||
+			added_polygon_count > polygons.get_capacity() - kept_polygon_count ||
+			free_polygon_slots.size() + removed_polygon_count > kept_polygon_count + added_polygon_count) {
+		region_sync_data.clear();
+		polygons.clear();
+		free_polygon_slots.clear();
+		connection_pairs_map.clear();
+		border_edge_merge_count = 0;
+
+		uint32_t polygon_count = 0;
 		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
-			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[polygon_count] = polygons_source[n];
-				polygons[polygon_count].id = polygon_count;
-				polygon_count++;
+			if (region->get_enabled()) {
+				polygon_count += region->get_polygons().size();
 			}
 		}
+		// Leave room for regions added later, they can then be linked without a full rebuild.
+		polygons.reserve(polygon_count + polygon_count / 2);
 
-		performance_data.pm_polygon_count = polygon_count;
+		for (NavRegion *region : regions) {
+			_add_region_polygons(region);
+		}
+		_update_free_edges(nullptr);
 
-		// Group all edges per key.
-		connection_pairs_map.clear();
-		connection_pairs_map.reserve(polygons.size());
-		int free_edges_count = 0; // How many ConnectionPairs have only one Connection.
-
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				const int next_point = (p + 1) % poly.points.size();
-				const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey>::Iterator pair_it = connection_pairs_map.find(ek);
-				if (!pair_it) {
-					pair_it = connection_pairs_map.insert(ek, ConnectionPair());
-					performance_data.pm_edge_count += 1;
-					++free_edges_count;
+		all_regions_dirty = false;
+	} else {
+		LocalVector<AABB> changed_bounds;
+
+		for (NavRegion *region : removed_regions) {
+			HashMap<NavRegion *, RegionSyncData>::Iterator data_it = region_sync_data.find(region);
+			if (data_it) {
+				if (data_it->value.bvh.root >= 0) {
+					changed_bounds.push_back(data_it->value.bvh.nodes[data_it->value.bvh.root].aabb);
 				}
-				ConnectionPair &pair = pair_it->value;
-				if (pair.size < 2) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-
-					pair.connections[pair.size] = new_connection;
-					++pair.size;
-					if (pair.size == 2) {
-						--free_edges_count;
-					}
-
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				_remove_region_polygons(data_it->value);
+				region_sync_data.remove(data_it);
+			}
+		}
+		for (NavRegion *region : dirty_regions) {
+			HashMap<NavRegion *, RegionSyncData>::Iterator data_it = region_sync_data.find(region);
+			if (data_it) {
+				if (data_it->value.bvh.root >= 0) {
+					changed_bounds.push_back(data_it->value.bvh.nodes[data_it->value.bvh.root].aabb);
 				}
+				_remove_region_polygons(data_it->value);
+				region_sync_data.remove(data_it);
+			}
+		}
+		for (NavRegion *region : dirty_regions) {
+			_add_region_polygons(region);
+			const gd::PolygonBVH &region_bvh = region_sync_data[region].bvh;
+			if (region_bvh.root >= 0) {
+				changed_bounds.push_back(region_bvh.nodes[region_bvh.root].aabb);
 			}
 		}
+		_update_free_edges(&changed_bounds);
+	}
 
-		free_edges.clear();
-		free_edges.reserve(free_edges_count);
+	dirty_regions.clear();
+	removed_regions.clear();
+
+	int polygon_count = 0;
+	int edge_merge_count = border_edge_merge_count;
+	LocalVector<const gd::PolygonBVH *> region_bvhs;
+	region_bvhs.reserve(region_sync_data.size());
+	for (const KeyValue<NavRegion *, RegionSyncData> &E : region_sync_data) {
+		polygon_count += E.value.polygon_slots.size();
+		edge_merge_count += E.value.edge_merge_count;
+		region_bvhs.push_back(&E.value.bvh);
+	}
+	performance_data.pm_polygon_count = polygon_count;
+	performance_data.pm_edge_count = edge_merge_count - border_edge_merge_count + connection_pairs_map.size();
+	performance_data.pm_edge_merge_count = edge_merge_count;
 
-		for (const KeyValue<gd::EdgeKey, ConnectionPair> &pair_it : connection_pairs_map) {
-			const ConnectionPair &pair = pair_it.value;
-			if (pair.size == 2) {
-				// Connect edge that are shared in different polygons.
-				const gd::Edge::Connection &c1 = pair.connections[0];
-				const gd::Edge::Connection &c2 = pair.connections[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				performance_data.pm_edge_merge_count += 1;
+	NavMeshQueries3D::polygons_merge_bvhs(region_bvhs, polygons_bvh);
+
+	// Gather the regions connections from the free edges, before the links add theirs.
+	region_external_connections.clear();
+	for (NavRegion *region : regions) {
+		region_external_connections[region] = LocalVector<gd::Edge::Connection>();
+	}
+	performance_data.pm_edge_connection_count = 0;
+	for (const gd::Edge::Connection &free_edge : free_edges) {
+		const LocalVector<gd::Edge::Connection> &connections = free_edge.polygon->edges[free_edge.edge].connections;
+		LocalVector<gd::Edge::Connection> &region_connections = region_external_connections[(NavRegion *)free_edge.polygon->owner];
+		for (const gd::Edge::Connection &connection : connections) {
+			region_connections.push_back(connection);
+		}
+		performance_data.pm_edge_connection_count += connections.size();
+	}
+}
+
+void NavMap::_add_region_polygons(NavRegion *p_region) {
+	RegionSyncData &data = region_sync_data.insert(p_region, RegionSyncData())->value;
+	if (!p_region->get_enabled()) {
+		return;
+	}
+
+	// Copy the region polygons in the map.
+	const LocalVector<gd::Polygon> &polygons_source = p_region->get_polygons();
+	data.polygon_slots.resize(polygons_source.size());
+	for (uint32_t n = 0; n < polygons_source.size(); n++) {
+		uint32_t slot = polygons.size();
+		if (free_polygon_slots.is_empty()) {
+			polygons.resize(slot + 1);
+		} else {
+			slot = free_polygon_slots[free_polygon_slots.size() - 1];
+			free_polygon_slots.resize(free_polygon_slots.size() - 1);
+		}
+		polygons[slot] = polygons_source[n];
+		polygons[slot].id = slot;
+		data.polygon_slots[n] = slot;
+	}
+	performance_data.pm_sync_polygon_count += polygons_source.size();
+
+	// Group the region edges per key.
+	HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey> region_pairs_map;
+	region_pairs_map.reserve(polygons_source.size());
+
+	for (uint32_t slot : data.polygon_slots) {
+		gd::Polygon &poly = polygons[slot];
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const int next_point = (p + 1) % poly.points.size();
+			const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey>::Iterator pair_it = region_pairs_map.find(ek);
+			if (!pair_it) {
+				pair_it = region_pairs_map.insert(ek, ConnectionPair());
+			}
+			ConnectionPair &pair = pair_it->value;
+			if (pair.size < 2) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+
+				pair.connections[pair.size] = new_connection;
+				++pair.size;
 			} else {
-				CRASH_COND_MSG(pair.size != 1, vformat("Number of connection != 1. Found: %d", pair.size));
-				if (use_edge_connections && pair.connections[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(pair.connections[0]);
-				}
+				// The edge is already connected with another edge, skip.
+				NAVMAP_EDGE_MERGE_ERROR_MSG();
 			}
 		}
+	}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		performance_data.pm_edge_free_count = free_edges.size();
+	for (const KeyValue<gd::EdgeKey, ConnectionPair> &pair_it : region_pairs_map) {
+		const ConnectionPair &pair = pair_it.value;
+		if (pair.size == 2) {
+			// Connect edge that are shared in different polygons.
+			const gd::Edge::Connection &c1 = pair.connections[0];
+			const gd::Edge::Connection &c2 = pair.connections[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			data.edge_merge_count += 1;
+			continue;
+		}
 
-		const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
+		// The edge is on the region border, it may be shared with another region.
+		HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey>::Iterator border_it = connection_pairs_map.find(pair_it.key);
+		if (!border_it) {
+			connection_pairs_map.insert(pair_it.key, pair);
+			continue;
+		}
+		ConnectionPair &border_pair = border_it->value;
+		if (border_pair.size == 2) {
+			NAVMAP_EDGE_MERGE_ERROR_MSG();
+			continue;
+		}
 
-		for (uint32_t i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+		const gd::Edge::Connection &c1 = border_pair.connections[0];
+		const gd::Edge::Connection &c2 = pair.connections[0];
+		// The other edge is no longer free, drop the connections it had to nearby edges.
+		c1.polygon->edges[c1.edge].connections.clear();
+		c1.polygon->edges[c1.edge].connections.push_back(c2);
+		c2.polygon->edges[c2.edge].connections.push_back(c1);
+		border_pair.connections[1] = c2;
+		border_pair.size = 2;
+		border_edge_merge_count += 1;
+	}
 
-			for (uint32_t j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
+	NavMeshQueries3D::polygons_build_bvh(polygons, data.polygon_slots, data.bvh);
+}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+void NavMap::_remove_region_polygons(RegionSyncData &p_data) {
+	// Only the border edges of the region are grouped map wide, its other edges are not found.
+	for (uint32_t slot : p_data.polygon_slots) {
+		const gd::Polygon &poly = polygons[slot];
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const int next_point = (p + 1) % poly.points.size();
+			const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+			HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey>::Iterator border_it = connection_pairs_map.find(ek);
+			if (!border_it) {
+				continue;
+			}
+			ConnectionPair &pair = border_it->value;
+			for (int i = 0; i < pair.size; i++) {
+				if (pair.connections[i].polygon != &poly || pair.connections[i].edge != (int)p) {
 					continue;
 				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
-					continue;
+				if (pair.size == 2) {
+					// The edge that was merged with this one is free again. Link connections are already
+					// removed at this point, so its only connection is the one to this edge.
+					const gd::Edge::Connection other = pair.connections[1 - i];
+					other.polygon->edges[other.edge].connections.clear();
+					pair.connections[0] = other;
+					border_edge_merge_count -= 1;
 				}
+				--pair.size;
+				break;
+			}
+			if (pair.size == 0) {
+				connection_pairs_map.remove(border_it);
+			}
+		}
+	}
+	performance_data.pm_sync_polygon_count += p_data.polygon_slots.size();
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
-					continue;
-				}
+	for (uint32_t slot : p_data.polygon_slots) {
+		polygons[slot] = gd::Polygon();
+		polygons[slot].id = slot;
+		free_polygon_slots.push_back(slot);
+	}
+	p_data.polygon_slots.clear();
+}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+void NavMap::_update_free_edges(const LocalVector<AABB> *p_changed_bounds) {
+	free_edges.clear();
 
-				// Add the connection to the region_connection map.
-				region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
-				performance_data.pm_edge_connection_count += 1;
+	if (use_edge_connections) {
+		for (const KeyValue<gd::EdgeKey, ConnectionPair> &pair_it : connection_pairs_map) {
+			const ConnectionPair &pair = pair_it.value;
+			CRASH_COND_MSG(pair.size != 1 && pair.size != 2, vformat("Number of connection != 1 or 2. Found: %d", pair.size));
+			if (pair.size == 1 && pair.connections[0].polygon->owner->get_use_edge_connections()) {
+				free_edges.push_back(pair.connections[0]);
 			}
 		}
+	}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	performance_data.pm_edge_free_count = free_edges.size();
+
+	// Connected edges are never farther apart than the margin, so only the free edges near the added or
+	// removed polygons can gain or lose connections. The others keep the connections they already have.
+	LocalVector<AABB> changed_bounds;
+	if (p_changed_bounds) {
+		changed_bounds.reserve(p_changed_bounds->size());
+		for (const AABB &bounds : *p_changed_bounds) {
+			changed_bounds.push_back(bounds.grow(edge_connection_margin + CMP_EPSILON));
+		}
+	}
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
+	LocalVector<uint32_t> affected_edges;
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		const gd::Edge::Connection &free_edge = free_edges[i];
+		if (p_changed_bounds) {
+			AABB edge_aabb(free_edge.polygon->points[free_edge.edge].pos, Vector3());
+			edge_aabb.expand_to(free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos);
+
+			bool affected = false;
+			for (const AABB &bounds : changed_bounds) {
+				if (bounds.intersects_inclusive(edge_aabb)) {
+					affected = true;
+					break;
+				}
+			}
+			if (!affected) {
 				continue;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_sqr_dist = link_connection_radius * link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_sqr_dist = link_connection_radius * link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t sqr_dist = start_point.distance_squared_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_start_sqr_dist) {
-						closest_start_sqr_dist = sqr_dist;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+		}
+		free_edge.polygon->edges[free_edge.edge].connections.clear();
+		affected_edges.push_back(i);
+	}
+
+	const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
+
+	for (uint32_t i : affected_edges) {
+		const gd::Edge::Connection &free_edge = free_edges[i];
+		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+		for (uint32_t j = 0; j < free_edges.size(); j++) {
+			const gd::Edge::Connection &other_edge = free_edges[j];
+			if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
+				continue;
 			}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t sqr_dist = end_point.distance_squared_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_end_sqr_dist) {
-						closest_end_sqr_dist = sqr_dist;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+			Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+
+			// Compute the projection of the opposite edge on the current one
+			Vector3 edge_vector = edge_p2 - edge_p1;
+			real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+			real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+			if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+				continue;
 			}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.id = polygon_count++;
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+			// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+			Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other1;
+			if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+				other1 = other_edge_p1;
+			} else {
+				other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
+				continue;
+			}
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
+			Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other2;
+			if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+				other2 = other_edge_p2;
+			} else {
+				other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
+				continue;
 			}
-		}
 
-		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
-		iteration_id = iteration_id % UINT32_MAX + 1;
+			// The edges can now be connected.
+			gd::Edge::Connection new_connection = other_edge;
+			new_connection.pathway_start = (self1 + other1) / 2.0;
+			new_connection.pathway_end = (self2 + other2) / 2.0;
+			free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+		}
 	}
+}
 
-	map_settings_dirty = false;
-	iteration_dirty = false;
+void NavMap::_sync_links() {
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
+	// Link polygon ids follow the map polygon slots.
+	uint32_t polygon_count = polygons.size();
 
-	_sync_avoidance();
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		// Pick the polygons within the search radius that are the closest to the start and end points.
+		Vector3 closest_start_point;
+		const gd::Polygon *start_polygon = NavMeshQueries3D::polygons_get_closest_polygon_in_radius(polygons, start, link_connection_radius, closest_start_point, &polygons_bvh);
+		gd::Polygon *closest_start_polygon = start_polygon ? &polygons[start_polygon->id] : nullptr;
+
+		Vector3 closest_end_point;
+		const gd::Polygon *end_polygon = NavMeshQueries3D::polygons_get_closest_polygon_in_radius(polygons, end, link_connection_radius, closest_end_point, &polygons_bvh);
+		gd::Polygon *closest_end_polygon = end_polygon ? &polygons[end_polygon->id] : nullptr;
+
+		// If we have both a start and end point, then create a synthetic polygon to route through.
+		if (closest_start_polygon && closest_end_polygon) {
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+			new_polygon.id = polygon_count++;
+			new_polygon.owner = link;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back(closest_start_polygon->id);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
+			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back(closest_end_polygon->id);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
+			}
+		}
+	}
 }
 
 void NavMap::_sync_avoidance() {
@@ -926,6 +1145,7 @@ void NavMap::_sync_dirty_map_update_requests() {
 		for (NavRegion *region : regions) {
 			region->scratch_polygons();
 		}
+		all_regions_dirty = true;
 		iteration_dirty = true;
 	}
 
@@ -935,7 +1155,10 @@ void NavMap::_sync_dirty_map_update_requests() {
 
 	// Sync NavRegions.
 	for (SelfList<NavRegion> *element = sync_dirty_requests.regions.first(); element; element = element->next()) {
-		element->self()->sync();
+		NavRegion *region = element->self();
+		if (region->sync() && !dirty_regions.has(region)) {
+			dirty_regions.push_back(region);
+		}
 	}
 	sync_dirty_requests.regions.clear();
 
@@ -965,7 +1188,14 @@ void NavMap::_sync_dirty_avoidance_update_requests() {
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
+	hierarchical_cluster_size = MAX(1, (int)GLOBAL_GET("navigation/pathfinding/hierarchical_cluster_size"));
 }
 
 NavMap::~NavMap() {
+	for (gd::PathQuerySlot *slot : free_path_query_slots) {
+		memdelete(slot);
+	}
+	free_path_query_slots.clear();
 }
@@ -74,6 +74,8 @@ class NavMap : public NavRid {
 
 	bool map_settings_dirty = true;
 	bool iteration_dirty = true;
+	/// Forces the next iteration to rebuild the polygons and connections of all regions.
+	bool all_regions_dirty = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
@@ -83,7 +85,39 @@ class NavMap : public NavRid {
 	LocalVector<gd::Polygon> link_polygons;
 
 	/// Map polygons
+	/// The polygons of a region keep their slots until the region changes, removed regions leave free slots behind.
 	LocalVector<gd::Polygon> polygons;
+	LocalVector<uint32_t> free_polygon_slots;
+
+	struct RegionSyncData {
+		/// Slots of the region polygons in the map polygons.
+		LocalVector<uint32_t> polygon_slots;
+		/// Spatial index over the region polygons, the map BVH is merged from these.
+		gd::PolygonBVH bvh;
+		/// Edges merged inside the region, they never enter `connection_pairs_map`.
+		int edge_merge_count = 0;
+	};
+	HashMap<NavRegion *, RegionSyncData> region_sync_data;
+
+	/// Regions added, changed or removed since the last iteration.
+	/// Removed regions may already be freed, they are only used as keys.
+	LocalVector<NavRegion *> dirty_regions;
+	LocalVector<NavRegion *> removed_regions;
+
+	/// Map polygons that link polygons connected to in the last iteration.
+	LocalVector<uint32_t> link_connected_polygons;
+
+	/// Spatial index over the map polygons, rebuilt with them on each map iteration.
+	gd::PolygonBVH polygons_bvh;
+
+	/// Coarse cluster graph for long path queries, only built with hierarchical pathfinding enabled.
+	bool use_hierarchical_pathfinding = false;
+	uint32_t hierarchical_cluster_size = 64;
+	gd::PolygonClusters polygon_clusters;
+
+	/// Idle path query search buffers, one is taken by each running path query.
+	mutable Mutex path_query_slots_mutex;
+	mutable LocalVector<gd::PathQuerySlot *> free_path_query_slots;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -125,7 +159,9 @@ class NavMap : public NavRid {
 		int size = 0;
 	};
 
+	/// Edges on the border of their region, grouped per key.
 	HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey> connection_pairs_map;
+	int border_edge_merge_count = 0;
 	LocalVector<gd::Edge::Connection> free_edges;
 
 	struct {
@@ -228,6 +264,7 @@ public:
 	int get_pm_edge_connection_count() const { return performance_data.pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return performance_data.pm_edge_free_count; }
 	int get_pm_obstacle_count() const { return performance_data.pm_obstacle_count; }
+	int get_pm_sync_polygon_count() const { return performance_data.pm_sync_polygon_count; }
 
 	int get_region_connections_count(NavRegion *p_region) const;
 	Vector3 get_region_connection_pathway_start(NavRegion *p_region, int p_connection_id) const;
@@ -247,6 +284,12 @@ private:
 	void _sync_dirty_map_update_requests();
 	void _sync_dirty_avoidance_update_requests();
 
+	void _sync_regions();
+	void _sync_links();
+	void _add_region_polygons(NavRegion *p_region);
+	void _remove_region_polygons(RegionSyncData &p_data);
+	void _update_free_edges(const LocalVector<AABB> *p_changed_bounds);
+
 	void compute_single_step(uint32_t index, NavAgent **agent);
 
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
@@ -259,6 +302,9 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	gd::PathQuerySlot *_acquire_path_query_slot() const;
+	void _release_path_query_slot(gd::PathQuerySlot *p_slot) const;
 };
 
 #endif // NAV_MAP_H
@@ -31,6 +31,7 @@
 #ifndef NAV_UTILS_H
 #define NAV_UTILS_H
 
+#include "core/math/aabb.h"
 #include "core/math/vector3.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
@@ -175,6 +176,59 @@ struct ClosestPointQueryResult {
 	RID owner;
 };
 
+struct PolygonBVHNode {
+	AABB aabb;
+
+	/// Children of an internal node, -1 on leaves.
+	int32_t left = -1;
+	int32_t right = -1;
+
+	/// Range of `PolygonBVH::polygon_indices` covered by the node and its children.
+	uint32_t first = 0;
+	uint32_t count = 0;
+};
+
+/// Bounding volume hierarchy over the polygons of a map, used to speed up closest point queries.
+struct PolygonBVH {
+	LocalVector<PolygonBVHNode> nodes;
+	LocalVector<uint32_t> polygon_indices;
+	int32_t root = -1;
+
+	void clear() {
+		nodes.clear();
+		polygon_indices.clear();
+		root = -1;
+	}
+};
+
+struct ClusterLink {
+	uint32_t cluster = 0;
+	/// Navigation layers of the polygons entered through this link.
+	uint32_t navigation_layers = 0;
+	real_t cost = 0.0;
+};
+
+/// Coarse graph over groups of neighboring polygons, used to narrow long path searches down to a corridor.
+struct PolygonClusters {
+	/// Cluster of each polygon, by polygon id.
+	LocalVector<uint32_t> polygon_clusters;
+	LocalVector<Vector3> cluster_centers;
+	/// The links of cluster `i` are `cluster_links[cluster_link_offsets[i]]` to `cluster_links[cluster_link_offsets[i + 1] - 1]`.
+	LocalVector<uint32_t> cluster_link_offsets;
+	LocalVector<ClusterLink> cluster_links;
+
+	bool is_empty() const {
+		return cluster_centers.is_empty();
+	}
+
+	void clear() {
+		polygon_clusters.clear();
+		cluster_centers.clear();
+		cluster_link_offsets.clear();
+		cluster_links.clear();
+	}
+};
+
 template <typename T>
 struct NoopIndexer {
 	void operator()(const T &p_value, uint32_t p_index) {}
@@ -299,6 +353,36 @@ private:
 	}
 };
 
+struct ClusterQueueEntry {
+	real_t total_travel_cost = 0.0;
+	real_t traveled_distance = 0.0;
+	uint32_t cluster = 0;
+};
+
+struct ClusterQueueEntryGreaterThan {
+	bool operator()(const ClusterQueueEntry &p_a, const ClusterQueueEntry &p_b) const {
+		return p_a.total_travel_cost > p_b.total_travel_cost;
+	}
+};
+
+/// Reusable A* search state for a single path query.
+/// A map keeps one slot per thread that can query it concurrently.
+struct PathQuerySlot {
+	LocalVector<NavigationPoly> navigation_polys;
+	Heap<NavigationPoly *, NavPolyTravelCostGreaterThan, NavPolyHeapIndexer> traversable_polys;
+	/// Ids of the navigation polys written by the last query.
+	LocalVector<uint32_t> touched_polys;
+	/// Number of polygons the last query expanded.
+	uint32_t expanded_polygon_count = 0;
+
+	/// Coarse search over the map clusters.
+	Heap<ClusterQueueEntry, ClusterQueueEntryGreaterThan> traversable_clusters;
+	LocalVector<real_t> cluster_traveled_distances;
+	LocalVector<int32_t> cluster_back_ids;
+	/// Clusters the polygon search is allowed to enter.
+	LocalVector<uint8_t> cluster_corridor;
+};
+
 struct PerformanceData {
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -309,6 +393,8 @@ struct PerformanceData {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	/// Polygons added to or removed from the map by the last synchronization.
+	int pm_sync_polygon_count = 0;
 };
 
 } // namespace gd
@@ -0,0 +1,235 @@
+/**************************************************************************/
+/*  test_nav_mesh_queries_3d.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_MESH_QUERIES_3D_H
+#define TEST_NAV_MESH_QUERIES_3D_H
+
+#ifndef _3D_DISABLED
+
+#include "../3d/nav_mesh_queries_3d.h"
+#include "../nav_region.h"
+
+#include "core/math/random_number_generator.h"
+#include "tests/test_macros.h"
+
+namespace TestNavMeshQueries3D {
+
+// Generates a bumpy terrain of `p_side` * `p_side` quads alternating between two owners.
+static void make_terrain(int p_side, NavRegion *p_region_a, NavRegion *p_region_b, LocalVector<gd::Polygon> &r_polygons) {
+	r_polygons.resize(p_side * p_side);
+	for (int x = 0; x < p_side; x++) {
+		for (int z = 0; z < p_side; z++) {
+			gd::Polygon &polygon = r_polygons[x * p_side + z];
+			polygon.id = x * p_side + z;
+			polygon.owner = ((x + z) % 2) ? p_region_a : p_region_b;
+			const int corners[4][2] = { { x, z }, { x, z + 1 }, { x + 1, z + 1 }, { x + 1, z } };
+			for (int i = 0; i < 4; i++) {
+				real_t height = Math::sin(corners[i][0] * 0.3) * Math::cos(corners[i][1] * 0.2) * 2.0;
+				gd::Point point;
+				point.pos = Vector3(corners[i][0], height, corners[i][1]);
+				polygon.points.push_back(point);
+			}
+			polygon.edges.resize(polygon.points.size());
+		}
+	}
+}
+
+// Connects the quads of a terrain made by `make_terrain` to their neighbors and turns every
+// 40th row into a wall owned by `p_wall_region`, with a gap every 50 quads.
+static void connect_terrain(int p_side, NavRegion *p_ground_region, NavRegion *p_wall_region, LocalVector<gd::Polygon> &r_polygons) {
+	for (int x = 0; x < p_side; x++) {
+		for (int z = 0; z < p_side; z++) {
+			gd::Polygon &polygon = r_polygons[x * p_side + z];
+			polygon.owner = (x % 40 == 20 && z % 50 > 3) ? p_wall_region : p_ground_region;
+			// Neighbors across the edges made by the corners of `make_terrain`.
+			const int neighbors[4][2] = { { x - 1, z }, { x, z + 1 }, { x + 1, z }, { x, z - 1 } };
+			for (int edge = 0; edge < 4; edge++) {
+				const int neighbor_x = neighbors[edge][0];
+				const int neighbor_z = neighbors[edge][1];
+				if (neighbor_x < 0 || neighbor_z < 0 || neighbor_x >= p_side || neighbor_z >= p_side) {
+					continue;
+				}
+				gd::Edge::Connection connection;
+				connection.polygon = &r_polygons[neighbor_x * p_side + neighbor_z];
+				connection.edge = edge;
+				connection.pathway_start = polygon.points[edge].pos;
+				connection.pathway_end = polygon.points[(edge + 1) % 4].pos;
+				polygon.edges[edge].connections.push_back(connection);
+			}
+		}
+	}
+}
+
+TEST_CASE("[Navigation3D][NavMeshQueries3D] BVH queries match the linear scan") {
+	const int side = 64;
+	const int query_count = 500;
+
+	NavRegion region_a;
+	NavRegion region_b;
+	region_b.set_navigation_layers(2);
+	LocalVector<gd::Polygon> polygons;
+	make_terrain(side, &region_a, &region_b, polygons);
+
+	gd::PolygonBVH bvh;
+	NavMeshQueries3D::polygons_build_bvh(polygons, bvh);
+	CHECK_MESSAGE(bvh.root >= 0, "The BVH should have a root node.");
+	CHECK_MESSAGE(bvh.polygon_indices.size() == polygons.size(), "The BVH should contain all polygons.");
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(4242);
+
+	bool same_closest_point = true;
+	bool same_segment_point = true;
+	bool same_collision_point = true;
+	bool same_link_polygon = true;
+	bool same_path = true;
+	uint64_t linear_usec = 0;
+	uint64_t bvh_usec = 0;
+
+	for (int i = 0; i < query_count; i++) {
+		Vector3 point(rng->randf_range(-8, side + 8), rng->randf_range(-6, 6), rng->randf_range(-8, side + 8));
+		Vector3 other(rng->randf_range(-8, side + 8), rng->randf_range(-6, 6), rng->randf_range(-8, side + 8));
+
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		gd::ClosestPointQueryResult linear = NavMeshQueries3D::polygons_get_closest_point_info(polygons, point);
+		linear_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+		gd::ClosestPointQueryResult indexed = NavMeshQueries3D::polygons_get_closest_point_info(polygons, point, &bvh);
+		bvh_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		//Reduce number of check messages
+		// Ties between polygons may pick a different one, compare the distances.
+		same_closest_point &= Math::is_equal_approx(linear.point.distance_to(point), indexed.point.distance_to(point));
+
+		Vector3 linear_segment = NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, point, other, false);
+		Vector3 indexed_segment = NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, point, other, false, &bvh);
+		same_segment_point &= linear_segment.is_equal_approx(indexed_segment);
+
+		linear_segment = NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, point, other, true);
+		indexed_segment = NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, point, other, true, &bvh);
+		same_collision_point &= linear_segment.is_equal_approx(indexed_segment);
+
+		Vector3 linear_link_point;
+		Vector3 indexed_link_point;
+		const gd::Polygon *linear_link_polygon = NavMeshQueries3D::polygons_get_closest_polygon_in_radius(polygons, point, 2.0, linear_link_point);
+		const gd::Polygon *indexed_link_polygon = NavMeshQueries3D::polygons_get_closest_polygon_in_radius(polygons, point, 2.0, indexed_link_point, &bvh);
+		same_link_polygon &= (linear_link_polygon == nullptr) == (indexed_link_polygon == nullptr);
+		same_link_polygon &= Math::is_equal_approx(linear_link_point.distance_to(point), indexed_link_point.distance_to(point));
+
+		Vector<Vector3> linear_path = NavMeshQueries3D::polygons_get_path(polygons, point, other, true, 2, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0);
+		Vector<Vector3> indexed_path = NavMeshQueries3D::polygons_get_path(polygons, point, other, true, 2, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0, &bvh);
+		// The start point is shared by all the polygons around a vertex, the rest of the path depends on which one wins.
+		same_path &= linear_path.size() == indexed_path.size() && (linear_path.is_empty() || linear_path[0].is_equal_approx(indexed_path[0]));
+	}
+
+	CHECK_MESSAGE(same_closest_point, "Closest points should be as close as with the linear scan.");
+	CHECK_MESSAGE(same_segment_point, "Closest points to segments should be as close as with the linear scan.");
+	CHECK_MESSAGE(same_collision_point, "Segment intersections should match the linear scan.");
+	CHECK_MESSAGE(same_link_polygon, "Polygons found within a radius should match the linear scan.");
+	CHECK_MESSAGE(same_path, "Path start and end polygons should match the linear scan.");
+
+	MESSAGE(vformat("Closest point on %d polygons: %.3f us per query linear, %.3f us per query with BVH.", polygons.size(), (double)linear_usec / query_count, (double)bvh_usec / query_count));
+}
+
+TEST_CASE("[Navigation3D][NavMeshQueries3D] Hierarchical path queries") {
+	const int side = 200;
+	const int query_count = 50;
+
+	NavRegion ground_region;
+	NavRegion wall_region;
+	wall_region.set_navigation_layers(2);
+	LocalVector<gd::Polygon> polygons;
+	make_terrain(side, &ground_region, &wall_region, polygons);
+	connect_terrain(side, &ground_region, &wall_region, polygons);
+
+	gd::PolygonBVH bvh;
+	NavMeshQueries3D::polygons_build_bvh(polygons, bvh);
+	LocalVector<gd::Polygon> link_polygons;
+	gd::PolygonClusters clusters;
+	NavMeshQueries3D::polygons_build_clusters(polygons, link_polygons, bvh, 64, clusters);
+	CHECK_MESSAGE(clusters.cluster_centers.size() > 1, "The map should be split in several clusters.");
+	CHECK_MESSAGE(clusters.polygon_clusters.size() == polygons.size(), "Every polygon should have a cluster.");
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1337);
+
+	gd::PathQuerySlot slot;
+	bool same_end_point = true;
+	uint64_t full_usec = 0;
+	uint64_t hierarchical_usec = 0;
+	uint64_t full_expanded = 0;
+	uint64_t hierarchical_expanded = 0;
+
+	for (int i = 0; i < query_count; i++) {
+		Vector3 point(rng->randf_range(0, side), 0, rng->randf_range(0, side));
+		Vector3 other(rng->randf_range(0, side), 0, rng->randf_range(0, side));
+
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		Vector<Vector3> full_path = NavMeshQueries3D::polygons_get_path(polygons, point, other, true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0, &bvh, &slot);
+		full_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+		full_expanded += slot.expanded_polygon_count;
+
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+		Vector<Vector3> hierarchical_path = NavMeshQueries3D::polygons_get_path(polygons, point, other, true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0, &bvh, &slot, &clusters);
+		hierarchical_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+		hierarchical_expanded += slot.expanded_polygon_count;
+
+		//Reduce number of check messages
+		same_end_point &= !full_path.is_empty() && !hierarchical_path.is_empty() && full_path[full_path.size() - 1].is_equal_approx(hierarchical_path[hierarchical_path.size() - 1]);
+	}
+
+	CHECK_MESSAGE(same_end_point, "Hierarchical paths should reach the same end point as full searches.");
+	CHECK_MESSAGE(hierarchical_expanded < full_expanded, "Hierarchical paths should expand fewer polygons.");
+
+	MESSAGE(vformat("Path on %d polygons in %d clusters: %.3f ms and %d expanded polygons per query with full search, %.3f ms and %d with clusters.",
+			polygons.size(), clusters.cluster_centers.size(),
+			(double)full_usec / query_count / 1000.0, full_expanded / query_count,
+			(double)hierarchical_usec / query_count / 1000.0, hierarchical_expanded / query_count));
+}
+
+TEST_CASE("[Navigation3D][NavMeshQueries3D] BVH of an empty map") {
+	LocalVector<gd::Polygon> polygons;
+	gd::PolygonBVH bvh;
+	NavMeshQueries3D::polygons_build_bvh(polygons, bvh);
+	CHECK(bvh.root == -1);
+
+	gd::ClosestPointQueryResult result = NavMeshQueries3D::polygons_get_closest_point_info(polygons, Vector3(1, 2, 3), &bvh);
+	CHECK(result.owner == RID());
+	CHECK(result.point == Vector3());
+}
+
+} // namespace TestNavMeshQueries3D
+
+#endif // _3D_DISABLED
+
+#endif // TEST_NAV_MESH_QUERIES_3D_H
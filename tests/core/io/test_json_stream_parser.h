@@ -0,0 +1,264 @@
+/**************************************************************************/
+/*  test_json_stream_parser.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_JSON_STREAM_PARSER_H
+#define TEST_JSON_STREAM_PARSER_H
+
+#include "core/io/json.h"
+#include "core/io/json_stream_parser.h"
+#include "core/io/stream_peer.h"
+#include "core/os/os.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestJSONStreamParser {
+
+static const char *test_document = R"({
+	"name": "Godot\nEngine é😀 \"quoted\" café 日本",
+	"version": 4,
+	"values": [1, -2.5, 3e2, 1234567890123456789, true, false, null],
+	"nested": {"empty_object": {}, "empty_array": [], "deep": [[["x"]]]},
+	"floats": [0.5, 1.5, -2, 4]
+})";
+
+static PackedByteArray _to_bytes(const String &p_string) {
+	return p_string.to_utf8_buffer();
+}
+
+TEST_CASE("[JSONStreamParser] Events") {
+	Ref<JSONStreamParser> parser;
+	parser.instantiate();
+	parser->append_data(_to_bytes(R"({"a": [1, "b"], "c": null})"));
+	parser->finish_data();
+
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_OBJECT_START);
+	CHECK(parser->get_depth() == 1);
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_KEY);
+	CHECK(parser->get_value() == "a");
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_ARRAY_START);
+	CHECK(parser->get_depth() == 2);
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_VALUE);
+	CHECK(parser->get_value() == Variant(1.0));
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_VALUE);
+	CHECK(parser->get_value() == "b");
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_ARRAY_END);
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_KEY);
+	CHECK(parser->get_value() == "c");
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_VALUE);
+	CHECK(parser->get_value() == Variant());
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_OBJECT_END);
+	CHECK(parser->get_depth() == 0);
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_DONE);
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_DONE);
+}
+
+TEST_CASE("[JSONStreamParser] Same result as JSON") {
+	const Variant expected = JSON::parse_string(String::utf8(test_document));
+
+	Ref<JSONStreamParser> parser;
+	parser.instantiate();
+	parser->append_data(_to_bytes(String::utf8(test_document)));
+	parser->finish_data();
+	CHECK(parser->parse() == OK);
+	CHECK(parser->get_data() == expected);
+
+	const Dictionary data = parser->get_data();
+	CHECK(String(data["name"]) == String::utf8("Godot\nEngine é😀 \"quoted\" café 日本"));
+}
+
+TEST_CASE("[JSONStreamParser] Incremental input") {
+	const Variant expected = JSON::parse_string(String::utf8(test_document));
+	const PackedByteArray bytes = _to_bytes(String::utf8(test_document));
+
+	Ref<JSONStreamParser> parser;
+	parser.instantiate();
+	for (int i = 0; i < bytes.size(); i++) {
+		CHECK(parser->parse() == ERR_BUSY);
+		parser->append_data(bytes.slice(i, i + 1));
+	}
+	// Something could still follow.
+	CHECK(parser->parse() == ERR_BUSY);
+	parser->finish_data();
+	CHECK(parser->parse() == OK);
+	CHECK(parser->get_data() == expected);
+
+	SUBCASE("Top-level numbers need the end of the input") {
+		parser->clear();
+		parser->append_data(_to_bytes("12"));
+		CHECK(parser->parse() == ERR_BUSY);
+		parser->append_data(_to_bytes("34"));
+		CHECK(parser->parse() == ERR_BUSY);
+		parser->finish_data();
+		CHECK(parser->parse() == OK);
+		CHECK(parser->get_data() == Variant(1234.0));
+	}
+}
+
+TEST_CASE("[JSONStreamParser] Reading from a stream") {
+	const Variant expected = JSON::parse_string(String::utf8(test_document));
+
+	Ref<StreamPeerBuffer> stream;
+	stream.instantiate();
+	Ref<JSONStreamParser> parser;
+	parser.instantiate();
+	parser->set_stream(stream);
+
+	const PackedByteArray bytes = _to_bytes(String::utf8(test_document));
+	const int half = bytes.size() / 2;
+	stream->put_data(bytes.ptr(), half);
+	stream->seek(0);
+	CHECK(parser->parse() == ERR_BUSY);
+
+	stream->set_data_array(bytes.slice(half));
+	CHECK(parser->parse() == ERR_BUSY);
+	parser->finish_data();
+	CHECK(parser->parse() == OK);
+	CHECK(parser->get_data() == expected);
+}
+
+TEST_CASE("[JSONStreamParser] Packed arrays") {
+	Ref<JSONStreamParser> parser;
+	parser.instantiate();
+	parser->set_use_packed_arrays(true);
+	parser->append_data(_to_bytes(String::utf8(test_document)));
+	parser->finish_data();
+	CHECK(parser->parse() == OK);
+
+	const Dictionary data = parser->get_data();
+	REQUIRE(data["floats"].get_type() == Variant::PACKED_FLOAT64_ARRAY);
+	const PackedFloat64Array floats = data["floats"];
+	CHECK(floats == PackedFloat64Array({ 0.5, 1.5, -2, 4 }));
+
+	// Mixed and empty arrays stay regular arrays.
+	CHECK(data["values"].get_type() == Variant::ARRAY);
+	CHECK(Array(data["values"]).size() == 7);
+	CHECK(Dictionary(data["nested"])["empty_array"].get_type() == Variant::ARRAY);
+}
+
+TEST_CASE("[JSONStreamParser] Errors") {
+	Ref<JSONStreamParser> parser;
+	parser.instantiate();
+
+	parser->append_data(_to_bytes("[1, 2"));
+	parser->finish_data();
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+
+	parser->clear();
+	parser->append_data(_to_bytes("[1\n 2]"));
+	parser->finish_data();
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+	CHECK(parser->get_error_message() == "Expected ','");
+	CHECK(parser->get_error_line() == 1);
+
+	parser->clear();
+	parser->append_data(_to_bytes(R"({"a": nope})"));
+	parser->finish_data();
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+	CHECK(parser->next_event() == JSONStreamParser::EVENT_ERROR);
+
+	parser->clear();
+	parser->append_data(_to_bytes(R"(["\ud83d"])"));
+	parser->finish_data();
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+
+	parser->clear();
+	parser->append_data(_to_bytes("{} {}"));
+	parser->finish_data();
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+	CHECK(parser->get_error_message() == "Expected 'EOF'");
+
+	// Trailing content arriving after the top-level value.
+	parser->clear();
+	parser->append_data(_to_bytes("{} "));
+	CHECK(parser->parse() == ERR_BUSY);
+	parser->append_data(_to_bytes("[]"));
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+	CHECK(parser->get_error_message() == "Expected 'EOF'");
+
+	parser->clear();
+	parser->append_data(_to_bytes("[1] "));
+	CHECK(parser->parse() == ERR_BUSY);
+	parser->append_data(_to_bytes("x"));
+	parser->finish_data();
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+
+	parser->clear();
+	parser->append_data(_to_bytes(R"("unterminated)"));
+	parser->finish_data();
+	CHECK(parser->parse() == ERR_PARSE_ERROR);
+}
+
+TEST_CASE("[JSONStreamParser] Benchmark" * doctest::skip()) {
+	// Run with `--test --no-skip --test-case="*JSONStreamParser] Benchmark*"`.
+	// Parses a large document received as UTF-8 bytes, as it would come from
+	// a file or an HTTP request.
+	Array records;
+	for (int i = 0; i < 50000; i++) {
+		Dictionary record;
+		record["id"] = i;
+		record["name"] = vformat("Record number %d", i);
+		PackedFloat64Array samples;
+		for (int j = 0; j < 32; j++) {
+			samples.push_back(i * 0.25 + j);
+		}
+		record["samples"] = samples;
+		records.push_back(record);
+	}
+	const PackedByteArray bytes = JSON::stringify(records, "", false).to_utf8_buffer();
+
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	Ref<JSON> json;
+	json.instantiate();
+	CHECK(json->parse(String::utf8((const char *)bytes.ptr(), bytes.size())) == OK);
+	const uint64_t json_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	Ref<JSONStreamParser> parser;
+	parser.instantiate();
+	parser->append_data(bytes);
+	parser->finish_data();
+	CHECK(parser->parse() == OK);
+	const uint64_t stream_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	parser->clear();
+	parser->set_use_packed_arrays(true);
+	parser->append_data(bytes);
+	parser->finish_data();
+	CHECK(parser->parse() == OK);
+	const uint64_t packed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	CHECK(parser->get_data().get_type() == Variant::ARRAY);
+	MESSAGE(vformat("%d MiB: JSON %d usec, JSONStreamParser %d usec, with packed arrays %d usec.", bytes.size() / (1024 * 1024), json_usec, stream_usec, packed_usec));
+}
+
+} // namespace TestJSONStreamParser
+
+#endif // TEST_JSON_STREAM_PARSER_H
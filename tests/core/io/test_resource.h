@@ -166,6 +166,53 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading binary resources with sub-threads") {
+	// Large self-contained sub-resources get their properties set on the WorkerThreadPool.
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Main");
+	Array children;
+	for (int i = 0; i < 8; i++) {
+		PackedByteArray data;
+		data.resize(128 * 1024);
+		data.fill(i);
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		child->set_meta("data", data);
+		children.push_back(child);
+	}
+	resource->set_meta("children", children);
+	// Depends on one of the children, so it's only set up once that child is.
+	Ref<Resource> dependent = memnew(Resource);
+	dependent->set_meta("child", children[3]);
+	resource->set_meta("dependent", dependent);
+
+	const String save_path = TestUtils::get_temp_path("resource_sub_threads.res");
+	CHECK(ResourceSaver::save(resource, save_path) == OK);
+
+	CHECK(ResourceLoader::load_threaded_request(save_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	const Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Main");
+
+	const Array loaded_children = loaded->get_meta("children");
+	REQUIRE(loaded_children.size() == 8);
+	for (int i = 0; i < 8; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		const PackedByteArray data = child->get_meta("data");
+		CHECK(data.size() == 128 * 1024);
+		CHECK(data[0] == i);
+		CHECK(data[data.size() - 1] == i);
+	}
+
+	const Ref<Resource> loaded_dependent = loaded->get_meta("dependent");
+	REQUIRE(loaded_dependent.is_valid());
+	const Ref<Resource> loaded_child = loaded_dependent->get_meta("child");
+	CHECK(loaded_child == Ref<Resource>(loaded_children[3]));
+	CHECK(loaded_child->get_name() == "Child 3");
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -34,6 +34,7 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -602,6 +603,80 @@ TEST_CASE("[Object] Destruction at the end of the call chain is safe") {
 			"Object was tail-deleted without crashes.");
 }
 
+class _SignalCounter : public Object {
+public:
+	int count = 0;
+	Object *emitter = nullptr;
+	_SignalCounter *disconnect_target = nullptr;
+
+	void on_emitted() {
+		count++;
+		if (disconnect_target) {
+			emitter->disconnect("my_signal", callable_mp(disconnect_target, &_SignalCounter::on_emitted));
+			disconnect_target = nullptr;
+		}
+	}
+};
+
+TEST_CASE("[Object] Signal emission uses the slots connected when it started") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("my_signal"));
+
+	_SignalCounter counters[3];
+	for (_SignalCounter &counter : counters) {
+		counter.emitter = &emitter;
+		emitter.connect("my_signal", callable_mp(&counter, &_SignalCounter::on_emitted));
+	}
+	_SignalCounter one_shot;
+	emitter.connect("my_signal", callable_mp(&one_shot, &_SignalCounter::on_emitted), Object::CONNECT_ONE_SHOT);
+
+	// Disconnecting a slot while emitting doesn't affect the current emission.
+	counters[0].disconnect_target = &counters[1];
+	CHECK(emitter.emit_signal("my_signal") == OK);
+	CHECK(counters[0].count == 1);
+	CHECK(counters[1].count == 1);
+	CHECK(counters[2].count == 1);
+	CHECK(one_shot.count == 1);
+
+	CHECK(emitter.emit_signal("my_signal") == OK);
+	CHECK(counters[0].count == 2);
+	CHECK(counters[1].count == 1);
+	CHECK(counters[2].count == 2);
+	CHECK(one_shot.count == 1);
+	CHECK_FALSE(emitter.is_connected("my_signal", callable_mp(&one_shot, &_SignalCounter::on_emitted)));
+
+	// Connecting again after the snapshot was taken.
+	emitter.connect("my_signal", callable_mp(&counters[1], &_SignalCounter::on_emitted));
+	CHECK(emitter.emit_signal("my_signal") == OK);
+	CHECK(counters[1].count == 2);
+}
+
+TEST_CASE("[Object] Signal emission benchmark" * doctest::skip()) {
+	// Run with `--test --no-skip --test-case="*emission benchmark*"`.
+	const int listener_counts[] = { 0, 1, 16 };
+	const int emissions = 1000000;
+
+	for (int listener_count : listener_counts) {
+		Object emitter;
+		emitter.add_user_signal(MethodInfo("my_signal"));
+		_SignalCounter counters[16];
+		for (int i = 0; i < listener_count; i++) {
+			emitter.connect("my_signal", callable_mp(&counters[i], &_SignalCounter::on_emitted));
+		}
+
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emissions; i++) {
+			emitter.emit_signal(SNAME("my_signal"));
+		}
+		const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+		MESSAGE(vformat("%d listeners: %.2f million emissions per second (%d emissions in %d usec).", listener_count, emissions / double(elapsed_usec), emissions, elapsed_usec));
+		for (int i = 0; i < listener_count; i++) {
+			CHECK(counters[i].count == emissions);
+		}
+	}
+}
+
 } // namespace TestObject
 
 #endif // TEST_OBJECT_H
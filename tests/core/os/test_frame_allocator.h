@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_frame_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ALLOCATOR_H
+#define TEST_FRAME_ALLOCATOR_H
+
+#include "core/os/frame_allocator.h"
+#include "core/os/os.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestFrameAllocator {
+
+TEST_CASE("[FrameAllocator] Allocations are aligned and distinct") {
+	FrameAllocator::end_frame();
+
+	uint8_t *a = (uint8_t *)FrameAllocator::alloc(3);
+	uint8_t *b = (uint8_t *)FrameAllocator::alloc(17);
+	uint8_t *c = (uint8_t *)FrameAllocator::alloc(256 * 1024); // Larger than a chunk.
+	uint8_t *d = (uint8_t *)FrameAllocator::alloc(1);
+
+	for (uint8_t *p : { a, b, c, d }) {
+		CHECK(((uintptr_t)p % alignof(max_align_t)) == 0);
+	}
+	CHECK(b >= a + 3);
+	CHECK(d != c);
+
+	memset(a, 0xAA, 3);
+	memset(b, 0xBB, 17);
+	memset(c, 0xCC, 256 * 1024);
+	memset(d, 0xDD, 1);
+	CHECK(a[2] == 0xAA);
+	CHECK(b[16] == 0xBB);
+	CHECK(c[256 * 1024 - 1] == 0xCC);
+	CHECK(d[0] == 0xDD);
+}
+
+TEST_CASE("[FrameAllocator] Realloc") {
+	FrameAllocator::end_frame();
+
+	uint32_t *a = (uint32_t *)FrameAllocator::realloc(nullptr, 0, 4 * sizeof(uint32_t));
+	for (uint32_t i = 0; i < 4; i++) {
+		a[i] = i;
+	}
+
+	// The last allocation grows in place.
+	uint32_t *grown = (uint32_t *)FrameAllocator::realloc(a, 4 * sizeof(uint32_t), 64 * sizeof(uint32_t));
+	CHECK(grown == a);
+
+	// Anything else is moved, keeping its contents.
+	FrameAllocator::alloc(8);
+	uint32_t *moved = (uint32_t *)FrameAllocator::realloc(grown, 64 * sizeof(uint32_t), 128 * sizeof(uint32_t));
+	CHECK(moved != grown);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+}
+
+TEST_CASE("[FrameAllocator] Memory stays valid until the end of the next frame") {
+	FrameAllocator::end_frame();
+
+	int *value = (int *)FrameAllocator::alloc(sizeof(int));
+	*value = 1234;
+
+	FrameAllocator::end_frame();
+	// Allocations in the next frame must not reuse the memory.
+	for (int i = 0; i < 1024; i++) {
+		*(int *)FrameAllocator::alloc(sizeof(int)) = -1;
+	}
+	CHECK(*value == 1234);
+}
+
+TEST_CASE("[FrameAllocator] FrameLocalVector") {
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 10000);
+	CHECK(vector[0] == 0);
+	CHECK(vector[9999] == 9999);
+
+	vector.erase(5000);
+	CHECK(vector.size() == 9999);
+	CHECK(vector.find(5000) == -1);
+
+	FrameLocalVector<int> copy = vector;
+	CHECK(copy.size() == 9999);
+	CHECK(copy[9998] == 9999);
+}
+
+TEST_CASE("[FrameAllocator] Steady frames don't allocate from the heap") {
+	// Let both arenas grow to fit the workload.
+	for (int frame = 0; frame < 4; frame++) {
+		FrameLocalVector<uint64_t> vector;
+		for (int i = 0; i < 100000; i++) {
+			vector.push_back(i);
+		}
+		FrameAllocator::end_frame();
+	}
+
+	const uint64_t reserved = FrameAllocator::get_reserved_memory();
+	const uint64_t alloc_count = Memory::get_alloc_count();
+	for (int frame = 0; frame < 4; frame++) {
+		FrameLocalVector<uint64_t> vector;
+		for (int i = 0; i < 100000; i++) {
+			vector.push_back(i);
+		}
+		FrameAllocator::end_frame();
+	}
+	CHECK(FrameAllocator::get_reserved_memory() == reserved);
+	CHECK(Memory::get_alloc_count() == alloc_count);
+	CHECK(FrameAllocator::get_arena_allocations_per_frame() > 0);
+
+	FrameAllocator::free_thread_arenas();
+}
+
+TEST_CASE("[FrameAllocator] Benchmark" * doctest::skip()) {
+	// Run with `--test --no-skip --test-case="*FrameAllocator] Benchmark*"`.
+	// Builds many small temporary vectors per frame, as culling and animation
+	// code does, with the default allocator and with the frame allocator.
+	const int frames = 100;
+	const int vectors = 1000;
+	const int elements = 64;
+
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < vectors; i++) {
+			LocalVector<uint32_t> vector;
+			for (int j = 0; j < elements; j++) {
+				vector.push_back(j);
+			}
+		}
+		FrameAllocator::end_frame();
+	}
+	const uint64_t default_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < vectors; i++) {
+			FrameLocalVector<uint32_t> vector;
+			for (int j = 0; j < elements; j++) {
+				vector.push_back(j);
+			}
+		}
+		FrameAllocator::end_frame();
+	}
+	const uint64_t frame_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	MESSAGE(vformat("LocalVector: %d usec, FrameLocalVector: %d usec.", default_usec, frame_usec));
+	FrameAllocator::free_thread_arenas();
+}
+
+} // namespace TestFrameAllocator
+
+#endif // TEST_FRAME_ALLOCATOR_H
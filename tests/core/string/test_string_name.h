@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+struct InterningState {
+	static constexpr int THREAD_COUNT = 8;
+
+	Vector<String> names;
+	int iterations = 0;
+	bool global_lock = false; // Serializes lookups, like the table did before it had shards.
+	Mutex mutex;
+	SafeNumeric<uint32_t> mismatches;
+	Thread threads[THREAD_COUNT];
+
+	void run_thread() {
+		for (int i = 0; i < iterations; i++) {
+			const String &name = names[i % names.size()];
+			if (global_lock) {
+				MutexLock lock(mutex);
+				const StringName string_name(name);
+				if (string_name != name) {
+					mismatches.increment();
+				}
+			} else {
+				const StringName string_name(name);
+				if (string_name != name) {
+					mismatches.increment();
+				}
+			}
+		}
+	}
+
+	static void thread_func(void *p_userdata) {
+		static_cast<InterningState *>(p_userdata)->run_thread();
+	}
+
+	void run() {
+		for (Thread &thread : threads) {
+			thread.start(thread_func, this);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+};
+
+static Vector<String> make_names(const String &p_prefix, int p_count) {
+	Vector<String> names;
+	for (int i = 0; i < p_count; i++) {
+		names.push_back(p_prefix + itos(i));
+	}
+	return names;
+}
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a("test_string_name_interning");
+	const StringName b(String("test_string_name_interning"));
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(StringName::search("test_string_name_interning") == a);
+	CHECK(StringName::search(U"test_string_name_interning") == a);
+	CHECK(StringName::search("test_string_name_not_interned") == StringName());
+	CHECK(StringName() == StringName(""));
+}
+
+TEST_CASE("[StringName] Names are removed when unreferenced") {
+	{
+		const StringName name("test_string_name_temporary");
+		CHECK(StringName::search("test_string_name_temporary") == name);
+	}
+	CHECK(StringName::search("test_string_name_temporary") == StringName());
+
+	// Adding it again after removal gives a valid name.
+	const StringName name("test_string_name_temporary");
+	CHECK(name == "test_string_name_temporary");
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	// Names are added, found and removed from several threads at once,
+	// all threads must agree on the result.
+	InterningState state;
+	state.names = make_names("test_string_name_concurrent_", 256);
+	state.iterations = 20000;
+	state.run();
+	CHECK(state.mismatches.get() == 0);
+
+	// Shared names end up with a single entry.
+	Vector<StringName> kept;
+	for (const String &name : state.names) {
+		kept.push_back(StringName(name));
+	}
+	state.run();
+	CHECK(state.mismatches.get() == 0);
+	for (int i = 0; i < kept.size(); i++) {
+		CHECK(StringName(state.names[i]).data_unique_pointer() == kept[i].data_unique_pointer());
+	}
+}
+
+TEST_CASE("[StringName] Concurrent lookup benchmark" * doctest::skip()) {
+	// Run with `--test --no-skip --test-case="*lookup benchmark*"`.
+	// Names are kept alive, so this measures lookups of existing names.
+	InterningState state;
+	state.names = make_names("test_string_name_benchmark_", 4096);
+	state.iterations = 1000000;
+	Vector<StringName> kept;
+	for (const String &name : state.names) {
+		kept.push_back(StringName(name));
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		state.global_lock = pass == 1;
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		state.run();
+		const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+		const uint64_t lookups = uint64_t(InterningState::THREAD_COUNT) * state.iterations;
+		MESSAGE(vformat("%s: %.2f million lookups per second (%d threads, %d usec).", state.global_lock ? "Global mutex" : "Sharded table", lookups / double(elapsed_usec), InterningState::THREAD_COUNT, elapsed_usec));
+	}
+	CHECK(state.mismatches.get() == 0);
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -173,6 +173,117 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_nested_leaf_task(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_nested_spawner_task(void *p_arg, uint32_t p_index) {
+	const int leaves = (int)(uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	task_ids.resize(leaves);
+	for (int i = 0; i < leaves; i++) {
+		task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf_task, nullptr, true);
+	}
+	// Pool threads wait collaboratively, so they run their own (or other threads') queued tasks meanwhile.
+	for (int i = 0; i < leaves; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_ids[i]);
+	}
+	counter[1].increment();
+}
+
+// Each spawner posts small tasks from its own pool thread, so all threads post and pop at once.
+// Returns the elapsed time, or 0 if any task didn't run exactly once.
+static uint64_t run_nested_tasks(bool p_work_stealing, int p_spawners, int p_leaves, int p_iterations) {
+	const bool work_stealing_backup = WorkerThreadPool::get_singleton()->is_work_stealing_enabled();
+	WorkerThreadPool::get_singleton()->set_work_stealing_enabled(p_work_stealing);
+
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	bool all_run = true;
+	for (int i = 0; i < p_iterations; i++) {
+		counter.clear();
+		counter.resize(2);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_spawner_task, (void *)(uintptr_t)p_leaves, p_spawners, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		//Reduce number of check messages
+		all_run &= counter[0].get() == p_spawners * p_leaves && counter[1].get() == p_spawners;
+	}
+	uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	WorkerThreadPool::get_singleton()->set_work_stealing_enabled(work_stealing_backup);
+	return all_run ? MAX(elapsed_usec, 1u) : 0;
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks spawned from pool threads, with and without work stealing") {
+	const int spawners = WorkerThreadPool::get_singleton()->get_thread_count() * 2;
+
+	CHECK_MESSAGE(run_nested_tasks(false, spawners, 32, 50) > 0, "All nested tasks should have run exactly once using the shared queue.");
+	// The group is posted from a non-pool thread, so it's spread across the local queues too.
+	CHECK_MESSAGE(run_nested_tasks(true, spawners, 32, 50) > 0, "All nested tasks should have run exactly once using local queues.");
+}
+
+TEST_CASE("[WorkerThreadPool] Task queue contention benchmark" * doctest::skip()) {
+	// Run with `--test --no-skip --test-case="*contention benchmark*"`.
+	// The shared queue is how every task was queued before work stealing was added.
+	const int spawners = WorkerThreadPool::get_singleton()->get_thread_count() * 4;
+	const int leaves = 256;
+	const int iterations = 100;
+	const uint64_t tasks = uint64_t(iterations) * spawners * (leaves + 1);
+
+	const uint64_t shared_usec = run_nested_tasks(false, spawners, leaves, iterations);
+	const uint64_t local_usec = run_nested_tasks(true, spawners, leaves, iterations);
+	REQUIRE(shared_usec > 0);
+	REQUIRE(local_usec > 0);
+
+	MESSAGE(vformat("Shared queue: %.2f million tasks per second (%d usec).", tasks / double(shared_usec), shared_usec));
+	MESSAGE(vformat("Local queues: %.2f million tasks per second (%d usec), %.2fx.", tasks / double(local_usec), local_usec, shared_usec / double(local_usec)));
+}
+
+static void static_graph_first_task(void *p_arg) {
+	OS::get_singleton()->delay_usec(1000); // Give dependents a chance to run too early, if broken.
+	counter[0].set(1);
+}
+
+static void static_graph_group_task(void *p_arg, uint32_t p_index) {
+	if (counter[0].get() == 1) {
+		counter[1].increment();
+	}
+}
+
+static void static_graph_last_task(void *p_arg) {
+	counter[2].set(counter[1].get());
+}
+
+TEST_CASE("[WorkerThreadPool] Run a dependency graph of tasks and group tasks") {
+	const int elements = 64;
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(3);
+
+		WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_graph_first_task, nullptr, !low_priority);
+		Vector<WorkerThreadPool::TaskID> group_dependencies = { first };
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_graph_group_task, nullptr, elements, group_dependencies, -1, low_priority);
+		Vector<WorkerThreadPool::TaskID> last_dependencies = { first, group };
+		WorkerThreadPool::TaskID last = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_graph_last_task, nullptr, last_dependencies, !low_priority);
+
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(last);
+		CHECK_MESSAGE(counter[2].get() == elements, "The last task should only run after the whole group, which should only run after the first task.");
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+	}
+
+	// Depending on tasks that were already awaited must not hold the new task back.
+	counter.clear();
+	counter.resize(3);
+	WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_graph_first_task, nullptr, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+	Vector<WorkerThreadPool::TaskID> dependencies = { first };
+	WorkerThreadPool::TaskID last = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_graph_last_task, nullptr, dependencies, true);
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(last) == OK);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
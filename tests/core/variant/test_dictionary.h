@@ -31,6 +31,7 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/os/os.h"
 #include "core/variant/typed_dictionary.h"
 #include "tests/test_macros.h"
 
@@ -594,6 +595,138 @@ TEST_CASE("[Dictionary] Typed copying") {
 	d6.clear();
 }
 
+TEST_CASE("[Dictionary] Order is kept when erasing and growing") {
+	// Large enough to go past the linear search of small dictionaries.
+	Dictionary d;
+	for (int i = 0; i < 100; i++) {
+		d[i] = i * 2;
+	}
+	for (int i = 0; i < 100; i += 3) {
+		CHECK(d.erase(i));
+	}
+	CHECK_FALSE(d.erase(0));
+	CHECK(d.size() == 66);
+	CHECK(d.get_key_at_index(0) == Variant(1));
+	CHECK(d.get_key_at_index(2) == Variant(4));
+	CHECK(d.get_value_at_index(2) == Variant(8));
+
+	// Erase most entries, so the remaining ones get compacted when adding more.
+	for (int i = 0; i < 90; i++) {
+		d.erase(i);
+	}
+	d[-1] = "last";
+	d["10"] = "string";
+	Array keys = build_array(91, 92, 94, 95, 97, 98, -1, "10");
+	CHECK_EQ(d.keys(), keys);
+	for (int i = 1000; i < 1100; i++) {
+		d[i] = i;
+		keys.push_back(i);
+	}
+	CHECK_EQ(d.keys(), keys);
+	for (int i = 1000; i < 1100; i++) {
+		d.erase(i);
+		keys.pop_back();
+	}
+	CHECK(d.has(97));
+	CHECK_FALSE(d.has(96));
+	CHECK(d[-1] == "last");
+	CHECK(d[StringName("10")] == "string");
+
+	// Iteration goes through the remaining entries in order.
+	const Variant *key = d.next(nullptr);
+	for (int i = 0; i < keys.size(); i++) {
+		REQUIRE(key);
+		CHECK(*key == keys[i]);
+		key = d.next(key);
+	}
+	CHECK(key == nullptr);
+
+	d.sort();
+	CHECK(d.get_key_at_index(0) == Variant(-1));
+
+	d.clear();
+	CHECK(d.is_empty());
+	d[1] = 1;
+	CHECK(d.keys() == build_array(1));
+}
+
+TEST_CASE("[Dictionary] Values keep their address when adding entries") {
+	Dictionary d;
+	d["first"] = 1;
+	const Variant *first = d.getptr("first");
+	for (int i = 0; i < 1000; i++) {
+		d[i] = i;
+	}
+	CHECK(d.getptr("first") == first);
+	CHECK(*first == Variant(1));
+}
+
+TEST_CASE("[Dictionary] Values keep their address when erasing entries") {
+	Dictionary d;
+	for (int i = 0; i < 100; i++) {
+		d[i] = i;
+	}
+	const Variant *last = d.getptr(99);
+	for (int i = 0; i < 99; i++) {
+		d.erase(i);
+	}
+	CHECK(d.getptr(99) == last);
+	CHECK(*last == Variant(99));
+}
+
+static void benchmark_dictionary(int p_size, int p_repeat) {
+	Vector<Variant> keys;
+	for (int i = 0; i < p_size; i++) {
+		keys.push_back(vformat("key_%d", i));
+	}
+
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	int64_t sum = 0;
+	for (int r = 0; r < p_repeat; r++) {
+		Dictionary d;
+		for (int i = 0; i < p_size; i++) {
+			d[keys[i]] = i;
+		}
+		sum += d.size();
+	}
+	const uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	Dictionary d;
+	for (int i = 0; i < p_size; i++) {
+		d[keys[i]] = i;
+	}
+
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < p_repeat; r++) {
+		for (int i = 0; i < p_size; i++) {
+			sum += int64_t(d[keys[i]]);
+		}
+	}
+	const uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < p_repeat; r++) {
+		for (const Variant *key = d.next(nullptr); key; key = d.next(key)) {
+			sum += key->get_type();
+		}
+		const Array values = d.values();
+		sum += values.size();
+	}
+	const uint64_t iterate_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	const double operations = double(p_size) * p_repeat;
+	MESSAGE(vformat("%d entries: insert %.1f ns, lookup %.1f ns, iterate %.1f ns per entry (checksum %d).",
+			p_size, insert_usec * 1000.0 / operations, lookup_usec * 1000.0 / operations, iterate_usec * 1000.0 / operations, sum));
+}
+
+TEST_CASE("[Dictionary] Benchmark" * doctest::skip()) {
+	// Run with `--test --no-skip --test-case="*Dictionary] Benchmark*"`.
+	benchmark_dictionary(4, 250000);
+	benchmark_dictionary(8, 125000);
+	benchmark_dictionary(64, 15000);
+	benchmark_dictionary(10000, 100);
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
@@ -103,6 +103,7 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_POLYGON_COUNT), 0);
 		}
 	}
 
@@ -389,6 +390,66 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(region);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should only synchronize changed regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A strip of two quads from (0, 0, 0) to (2, 0, 1).
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_vertices({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(2, 0, 0), Vector3(0, 0, 1), Vector3(1, 0, 1), Vector3(2, 0, 1) });
+		navigation_mesh->add_polygon({ 0, 3, 4, 1 });
+		navigation_mesh->add_polygon({ 1, 4, 5, 2 });
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID regions[3];
+		for (int i = 0; i < 3; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+			navigation_server->region_set_transform(regions[i], Transform3D(Basis(), Vector3(i * 2, 0, 0)));
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 6);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 5);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_POLYGON_COUNT), 6);
+
+		SUBCASE("An unchanged map should not synchronize any polygon") {
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_POLYGON_COUNT), 0);
+		}
+
+		SUBCASE("Moving a region should only synchronize its own polygons") {
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(4, 0, 5)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 6);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 4);
+			// The 2 old polygons are removed and the 2 moved polygons are added.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_POLYGON_COUNT), 4);
+
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(4, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 5);
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(5.5, 0, 0.5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(5.5, 0, 0.5)));
+		}
+
+		SUBCASE("Removing a region should only synchronize its own polygons") {
+			navigation_server->region_set_map(regions[0], RID());
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 4);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 3);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_POLYGON_COUNT), 2);
+		}
+
+		for (int i = 0; i < 3; i++) {
+			navigation_server->free(regions[i]);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to actually remove map.
+	}
+
 	// This test case does not check precise values on purpose - to not be too sensitivte.
 	TEST_CASE("[NavigationServer3D] Server should move agent properly") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -790,6 +851,31 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i % 4, 0, i / 4));
+				query_parameters->set_target_position(Vector3(10 - i / 4, 0, 10 - i % 4));
+				query_parameters->set_path_postprocessing(i % 2 ? NavigationPathQueryParameters3D::PATH_POSTPROCESSING_EDGECENTERED : NavigationPathQueryParameters3D::PATH_POSTPROCESSING_CORRIDORFUNNEL);
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			navigation_server->query_paths(batch_parameters, batch_results);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(batch_parameters[i], query_result);
+				Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_types(), query_result->get_path_types());
+				CHECK_EQ(batch_result->get_path_owner_ids(), query_result->get_path_owner_ids());
+			}
+		}
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.